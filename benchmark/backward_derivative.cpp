@@ -0,0 +1,64 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+#include <math.h>
+
+using namespace ns;
+
+constexpr size_t SAMPLES = 4096U;
+constexpr size_t REPEATS = 200U;
+constexpr size_t WARMUP = 200U;
+constexpr double DT = 0.001;
+constexpr double OMEGA = 2.0 * M_PI * 5.0;
+constexpr size_t C0 = 20U, C1 = 10U;
+
+// Nested SMAs of sin(w t) are A sin(w (t - D dt)), derivatives are exact.
+static double shaped(const double& t, const size_t& order) {
+    const double a0 = sin(OMEGA * DT * double(C0) / 2.0) / (double(C0) * sin(OMEGA * DT / 2.0));
+    const double a1 = sin(OMEGA * DT * double(C1) / 2.0) / (double(C1) * sin(OMEGA * DT / 2.0));
+    const double delay = (double(C0 - 1U) + double(C1 - 1U)) / 2.0 * DT;
+    return a0 * a1 * pow(OMEGA, double(order)) * sin(OMEGA * (t - delay) + double(order) * M_PI / 2.0);
+}
+
+template<typename Shaper, size_t N>
+void benchmarkDerivative(const char* name, const size_t& lag) {
+    static double input[SAMPLES];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = sin(OMEGA * DT * double(i));
+    }
+
+    // Accuracy, relative RMS error of velocity and acceleration at the output point of each sample
+    Shaper shaper{0.0};
+    double errors[3] = {0.0, 0.0, 0.0}, norms[3] = {0.0, 0.0, 0.0};
+    for(size_t i = 0; i < SAMPLES; i++) {
+        const array<double, N> derivatives = shaper.convolute(input[i], DT);
+        if(i < WARMUP) {
+            continue;
+        }
+
+        const double t = DT * double(i - lag);
+        for(size_t k = 1; k < 3; k++) {
+            const double expected = shaped(t, k);
+            errors[k] += (derivatives[k] - expected) * (derivatives[k] - expected);
+            norms[k] += expected * expected;
+        }
+    }
+
+    static Shaper timed{0.0};
+    const double ns = benchmark::measure(name, REPEATS, [&](const size_t&) {
+        for(size_t i = 0; i < SAMPLES; i++) {
+            benchmark::doNotOptimize(timed.convolute(input[i], DT));
+        }
+    });
+    printf("%-56s %10.3f ns/sample, lag %zu samples, velocity %.2e, acceleration %.2e\n", "", ns / double(SAMPLES), lag, sqrt(errors[1] / norms[1]), sqrt(errors[2] / norms[2]));
+}
+
+int main() {
+    printf("Central vs backward derivatives, 5 Hz sine at 1 kHz, relative RMS errors\n");
+    benchmarkDerivative<NestedShaperEuclideanRecursive<double, 3, C0, C1>, 3>("Central, N = 3", 1U);
+    benchmarkDerivative<NestedShaperEuclideanRecursiveBackward<double, 3, C0, C1>, 3>("Backward, N = 3", 0U);
+    benchmarkDerivative<NestedShaperEuclideanRecursive<double, 5, C0, C1>, 5>("Central, N = 5", 2U);
+    benchmarkDerivative<NestedShaperEuclideanRecursiveBackward<double, 5, C0, C1>, 5>("Backward, N = 5", 0U);
+    benchmarkDerivative<NestedShaperEuclideanRecursive<double, 9, C0, C1>, 9>("Central, N = 9", 4U);
+    benchmarkDerivative<NestedShaperEuclideanRecursiveBackward<double, 9, C0, C1>, 9>("Backward, N = 9", 0U);
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file benchmark.hpp
+ * 
+ * @brief Minimal timing helpers shared by benchmarks.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <stdio.h>
+
+namespace benchmark {
+/**
+ * Prevents the compiler from optimizing away the given value.
+ */
+template<typename Type>
+inline void doNotOptimize(const Type& value) {
+    asm volatile(""
+                 :
+                 : "r,m"(value)
+                 : "memory");
+}
+
+/**
+ * Runs function(i) for iterations times, prints and returns nanoseconds per iteration.
+ */
+template<typename Function>
+double measure(const char* name, const size_t& iterations, Function function) {
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; i++) {
+        function(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / double(iterations);
+    printf("%-56s %10.3f ns/iter\n", name, ns);
+    return ns;
+}
+}; // namespace benchmark
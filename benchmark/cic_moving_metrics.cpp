@@ -0,0 +1,36 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+#include <stdint.h>
+
+using namespace ns;
+
+constexpr size_t ITERATIONS = 2000000U;
+
+template<typename Shaper, typename Type, typename TimeType>
+void benchmarkShaper(const char* name, const TimeType& dt) {
+    static Shaper shaper{Type(0)};
+    benchmark::measure(name, ITERATIONS, [&](const size_t& i) {
+        benchmark::doNotOptimize(shaper.convolute(Type(i % 1000U), dt));
+    });
+}
+
+template<typename Nested, typename Type>
+void benchmarkNested(const char* name) {
+    static Nested nested{Type(0)};
+    benchmark::measure(name, ITERATIONS, [&](const size_t& i) {
+        benchmark::doNotOptimize(nested.convolute(Type(i % 1000U)));
+    });
+}
+
+int main() {
+    printf("Recursive vs Integer vs CIC\n");
+    benchmarkNested<MovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, 100, 50, 20>, double>("Recursive moving metrics (100, 50, 20)");
+    benchmarkNested<MovingMetricsNested<int64_t, EuclideanMeanIntegerMetrics<int64_t>, 100, 50, 20>, int64_t>("Integer moving metrics (100, 50, 20)");
+    benchmarkNested<CICMovingMetricsNested<int64_t, 100, 50, 20>, int64_t>("CIC moving metrics (100, 50, 20)");
+    benchmarkNested<MovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, 100, 100, 100, 100>, double>("Recursive moving metrics (100, 100, 100, 100)");
+    benchmarkNested<CICMovingMetricsNested<int64_t, 100, 100, 100, 100>, int64_t>("CIC moving metrics (100, 100, 100, 100)");
+    benchmarkShaper<NestedShaperEuclideanRecursive<double, 5, 100, 50, 20>, double>("NestedShaperEuclideanRecursive (100, 50, 20)", 0.001);
+    benchmarkShaper<NestedShaperInteger<int64_t, 5, 100, 50, 20>, int64_t>("NestedShaperInteger (100, 50, 20)", int64_t(1));
+    benchmarkShaper<NestedShaperCIC<int64_t, 5, 100, 50, 20>, int64_t>("NestedShaperCIC (100, 50, 20)", int64_t(1));
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+
+using namespace ns;
+
+constexpr size_t SAMPLES = 4096U;
+constexpr size_t REPEATS = 200U;
+
+template<typename Shaper>
+void benchmarkBlock(const char* sample_name, const char* block_name, const size_t& block) {
+    static double input[SAMPLES];
+    static array<double, 5> output[SAMPLES];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = double(i % 1000U);
+    }
+
+    Shaper shaper{0.0};
+    benchmark::measure(sample_name, REPEATS * SAMPLES, [&](const size_t& i) {
+        benchmark::doNotOptimize(shaper.convolute(input[i % SAMPLES], 0.001));
+    });
+
+    Shaper shaper_block{0.0};
+    const double ns = benchmark::measure(block_name, REPEATS * SAMPLES / block, [&](const size_t& i) {
+        const size_t offset = (i * block) % SAMPLES;
+        shaper_block.convoluteBlock(input + offset, output + offset, block, 0.001);
+        benchmark::doNotOptimize(output[offset]);
+    });
+    printf("%-56s %10.3f ns/sample\n", "", ns / double(block));
+}
+
+template<typename Nested>
+void benchmarkNested(const char* sample_name, const char* block_name) {
+    static double input[SAMPLES];
+    static double output[SAMPLES];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = double(i % 1000U);
+    }
+
+    Nested nested{0.0};
+    benchmark::measure(sample_name, REPEATS * SAMPLES, [&](const size_t& i) {
+        benchmark::doNotOptimize(nested.convolute(input[i % SAMPLES]));
+    });
+
+    Nested nested_block{0.0};
+    const double ns = benchmark::measure(block_name, REPEATS, [&](const size_t&) {
+        nested_block.convoluteBlock(input, output, SAMPLES);
+        benchmark::doNotOptimize(output[0]);
+    });
+    printf("%-56s %10.3f ns/sample\n", "", ns / double(SAMPLES));
+}
+
+using Cumulative = NestedShaperEuclideanCumulative<double, 5, 100, 50, 20>;
+using Recursive = NestedShaperEuclideanRecursive<double, 5, 100, 50, 20>;
+
+int main() {
+    printf("Moving metrics only, convolute vs convoluteBlock (block kernel for cumulative metrics)\n");
+    benchmarkNested<MovingMetricsNested<double, EuclideanMeanCumulativeMetrics<double>, 100, 50, 20>>("Cumulative moving metrics, convolute", "Cumulative moving metrics, convoluteBlock(4096)");
+    benchmarkNested<MovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, 100, 50, 20>>("Recursive moving metrics, convolute", "Recursive moving metrics, convoluteBlock(4096)");
+
+    printf("Shapers, convolute vs convoluteBlock\n");
+    benchmarkBlock<Cumulative>("Cumulative shaper, convolute", "Cumulative shaper, convoluteBlock(64)", 64U);
+    benchmarkBlock<Cumulative>("Cumulative shaper, convolute", "Cumulative shaper, convoluteBlock(4096)", 4096U);
+    benchmarkBlock<Recursive>("Recursive shaper, convolute", "Recursive shaper, convoluteBlock(64)", 64U);
+    benchmarkBlock<Recursive>("Recursive shaper, convolute", "Recursive shaper, convoluteBlock(4096)", 4096U);
+    return 0;
+}
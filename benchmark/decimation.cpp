@@ -0,0 +1,37 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+
+using namespace ns;
+
+constexpr size_t SAMPLES = 4096U;
+constexpr size_t REPEATS = 200U;
+
+template<typename Shaper>
+void benchmarkDecimation(const char* block_name, const char* decimated_name, const size_t& factor) {
+    static double input[SAMPLES];
+    static array<double, 5> output[SAMPLES];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = double(i % 1000U);
+    }
+
+    static Shaper shaper{0.0};
+    double ns = benchmark::measure(block_name, REPEATS, [&](const size_t&) {
+        shaper.convoluteBlock(input, output, SAMPLES, 0.000125);
+        benchmark::doNotOptimize(output[SAMPLES - 1U]);
+    });
+    printf("%-56s %10.3f ns/input sample\n", "", ns / double(SAMPLES));
+
+    static Shaper shaper_decimated{0.0};
+    shaper_decimated.setDecimation(factor);
+    ns = benchmark::measure(decimated_name, REPEATS, [&](const size_t&) {
+        benchmark::doNotOptimize(shaper_decimated.convoluteDecimated(input, output, SAMPLES, 0.000125));
+    });
+    printf("%-56s %10.3f ns/input sample\n", "", ns / double(SAMPLES));
+}
+
+int main() {
+    printf("convoluteBlock vs convoluteDecimated (8 kHz to 1 kHz)\n");
+    benchmarkDecimation<NestedShaperEuclideanRecursive<double, 5, 800, 400, 160>>("Recursive, convoluteBlock", "Recursive, convoluteDecimated(8)", 8U);
+    benchmarkDecimation<NestedShaperEuclideanCumulative<double, 5, 80, 40, 16>>("Cumulative, convoluteBlock", "Cumulative, convoluteDecimated(8)", 8U);
+    return 0;
+}
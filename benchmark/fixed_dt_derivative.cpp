@@ -0,0 +1,36 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+
+using namespace ns;
+
+constexpr size_t SAMPLES = 4096U;
+constexpr size_t REPEATS = 200U;
+
+template<typename Metrics, size_t N>
+void benchmarkMetrics(const char* name) {
+    static Queue<double, N> queue;
+    static double input[SAMPLES];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = double(i % 1000U) * 0.001;
+    }
+    queue.fill(0.0);
+
+    static Metrics metrics{};
+    initialize_derivative_metrics(metrics, 0.001, 0);
+    const double ns = benchmark::measure(name, REPEATS, [&](const size_t&) {
+        for(size_t i = 0; i < SAMPLES; i++) {
+            queue.push(input[i]);
+            benchmark::doNotOptimize(metrics(queue.forwardConstIterator(), queue.backwardConstIterator(), 0.001));
+        }
+    });
+    printf("%-56s %10.3f ns/sample\n", "", ns / double(SAMPLES));
+}
+
+int main() {
+    printf("Derivatives with dt per call vs coefficients scaled for a fixed dt\n");
+    benchmarkMetrics<EuclideanDerivativeMetrics<double, 5>, 5>("EuclideanDerivativeMetrics, N = 5");
+    benchmarkMetrics<EuclideanDerivativeFixedDtMetrics<double, 5>, 5>("EuclideanDerivativeFixedDtMetrics, N = 5");
+    benchmarkMetrics<EuclideanDerivativeMetrics<double, 9>, 9>("EuclideanDerivativeMetrics, N = 9");
+    benchmarkMetrics<EuclideanDerivativeFixedDtMetrics<double, 9>, 9>("EuclideanDerivativeFixedDtMetrics, N = 9");
+    return 0;
+}
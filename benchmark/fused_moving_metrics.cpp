@@ -0,0 +1,29 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+
+using namespace ns;
+
+constexpr size_t ITERATIONS = 2000000U;
+
+template<typename Nested>
+void benchmarkNested(const char* name) {
+    Nested nested{0.0};
+    benchmark::measure(name, ITERATIONS, [&](const size_t& i) {
+        benchmark::doNotOptimize(nested.convolute(double(i % 1000U)));
+    });
+}
+
+template<size_t Extent, size_t... Extents>
+void benchmarkStages(const char* chain_name, const char* fused_name) {
+    benchmarkNested<MovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, Extent, Extents...>>(chain_name);
+    benchmarkNested<FusedMovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, Extent, Extents...>>(fused_name);
+}
+
+int main() {
+    printf("MovingMetricsNested vs FusedMovingMetricsNested (recursive mean)\n");
+    benchmarkStages<20, 10>("2 stages, chain", "2 stages, fused");
+    benchmarkStages<20, 10, 8, 6>("4 stages, chain", "4 stages, fused");
+    benchmarkStages<20, 10, 8, 6, 5, 4>("6 stages, chain", "6 stages, fused");
+    benchmarkStages<20, 10, 8, 6, 5, 4, 3, 2>("8 stages, chain", "8 stages, fused");
+    return 0;
+}
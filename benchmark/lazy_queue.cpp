@@ -0,0 +1,32 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+
+using namespace ns;
+
+constexpr size_t ITERATIONS = 200000U;
+
+template<typename Shaper>
+void benchmarkInitialize(const char* name) {
+    static Shaper shaper{0.0};
+    benchmark::measure(name, ITERATIONS / 100U, [&](const size_t& i) {
+        shaper.initialize(double(i));
+        benchmark::doNotOptimize(shaper.convolute(double(i), 0.001));
+    });
+}
+
+template<typename Shaper>
+void benchmarkConvolute(const char* name) {
+    static Shaper shaper{0.0};
+    benchmark::measure(name, ITERATIONS, [&](const size_t& i) {
+        benchmark::doNotOptimize(shaper.convolute(double(i % 1000U), 0.001));
+    });
+}
+
+int main() {
+    printf("Queue vs LazyQueue\n");
+    benchmarkInitialize<NestedShaperEuclideanRecursive<double, 5, 8000, 4000, 2000>>("Initialize Queue (8000, 4000, 2000)");
+    benchmarkInitialize<NestedShaperEuclideanRecursiveLazy<double, 5, 8000, 4000, 2000>>("Initialize LazyQueue (8000, 4000, 2000)");
+    benchmarkConvolute<NestedShaperEuclideanRecursive<double, 5, 8000, 4000, 2000>>("Convolute Queue (8000, 4000, 2000)");
+    benchmarkConvolute<NestedShaperEuclideanRecursiveLazy<double, 5, 8000, 4000, 2000>>("Convolute LazyQueue (8000, 4000, 2000)");
+    return 0;
+}
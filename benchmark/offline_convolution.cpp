@@ -0,0 +1,40 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+#include <nested-shaper/OfflineConvolution.hpp>
+
+using namespace ns;
+
+constexpr size_t SAMPLES = 1U << 18U;
+constexpr size_t REPEATS = 4U;
+
+template<typename Shaper>
+void benchmarkOffline(const char* block_name, const char* offline_name) {
+    static double input[SAMPLES];
+    static array<double, 5> output[SAMPLES];
+    static double workspace[1U << 16U];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = double(i % 1000U);
+    }
+
+    static Shaper shaper{0.0};
+    double ns = benchmark::measure(block_name, REPEATS, [&](const size_t&) {
+        shaper.initialize(input[0]);
+        shaper.convoluteBlock(input, output, SAMPLES, 0.001);
+        benchmark::doNotOptimize(output[SAMPLES - 1U]);
+    });
+    printf("%-56s %10.3f ns/sample\n", "", ns / double(SAMPLES));
+
+    ns = benchmark::measure(offline_name, REPEATS, [&](const size_t&) {
+        shape_offline(shaper, input, output, SAMPLES, 0.001, workspace, sizeof(workspace) / sizeof(double));
+        benchmark::doNotOptimize(output[SAMPLES - 1U]);
+    });
+    printf("%-56s %10.3f ns/sample\n", "", ns / double(SAMPLES));
+}
+
+int main() {
+    printf("convoluteBlock vs shape_offline\n");
+    benchmarkOffline<NestedShaperEuclideanCumulative<double, 5, 100, 50, 20>>("Cumulative (100, 50, 20), convoluteBlock", "Cumulative (100, 50, 20), shape_offline");
+    benchmarkOffline<NestedShaperEuclideanCumulative<double, 5, 2000, 1000, 500>>("Cumulative (2000, 1000, 500), convoluteBlock", "Cumulative (2000, 1000, 500), shape_offline");
+    benchmarkOffline<NestedShaperEuclideanRecursive<double, 5, 2000, 1000, 500>>("Recursive (2000, 1000, 500), convoluteBlock", "Recursive (2000, 1000, 500), shape_offline");
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+#include <nested-shaper/PowerOfTwoQueue.hpp>
+
+using namespace ns;
+
+constexpr size_t ITERATIONS = 2000000U;
+
+template<template<typename, size_t> class QueueType>
+void benchmarkQueue(const char* push_name, const char* iterate_name) {
+    QueueType<double, 100> queue;
+    queue.fill(0.0);
+
+    benchmark::measure(push_name, ITERATIONS, [&](const size_t& i) {
+        queue.push(double(i));
+        benchmark::doNotOptimize(queue.front(3) + queue.back(7));
+    });
+
+    benchmark::measure(iterate_name, ITERATIONS / 10U, [&](const size_t& i) {
+        queue.push(double(i));
+        auto iterator = queue.forwardConstIterator();
+        double sum{0.0};
+        for(size_t j = 0; j < iterator.size; j += 3U) {
+            sum += *(iterator + j);
+        }
+        benchmark::doNotOptimize(sum);
+    });
+}
+
+template<typename Shaper>
+void benchmarkShaper(const char* name) {
+    Shaper shaper{0.0};
+    benchmark::measure(name, ITERATIONS, [&](const size_t& i) {
+        benchmark::doNotOptimize(shaper.convolute(double(i % 1000U), 0.001));
+    });
+}
+
+template<template<typename, size_t> class QueueType>
+using Cumulative = QueuedShaperMetrics<QueueType, double, EuclideanDerivativeMetrics<double, 5>, 5, EuclideanMeanCumulativeMetrics<double>, 100, 50, 20>;
+template<template<typename, size_t> class QueueType>
+using Recursive = QueuedShaperMetrics<QueueType, double, EuclideanDerivativeMetrics<double, 5>, 5, EuclideanMeanRecursiveMetrics<double>, 100, 50, 20>;
+
+int main() {
+    printf("Queue vs PowerOfTwoQueue\n");
+    benchmarkQueue<Queue>("Queue push + front/back", "Queue iterator + n");
+    benchmarkQueue<PowerOfTwoQueue>("PowerOfTwoQueue push + front/back", "PowerOfTwoQueue iterator + n");
+    benchmarkShaper<Cumulative<Queue>>("Cumulative shaper (100, 50, 20), Queue");
+    benchmarkShaper<Cumulative<PowerOfTwoQueue>>("Cumulative shaper (100, 50, 20), PowerOfTwoQueue");
+    benchmarkShaper<Recursive<Queue>>("Recursive shaper (100, 50, 20), Queue");
+    benchmarkShaper<Recursive<PowerOfTwoQueue>>("Recursive shaper (100, 50, 20), PowerOfTwoQueue");
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+#include <math.h>
+#include <stdint.h>
+
+using namespace ns;
+
+constexpr size_t ITERATIONS = 2000000U;
+constexpr size_t DRIFT_SAMPLES = 10000000U;
+constexpr size_t WINDOW = 100U;
+
+template<typename Shaper>
+void benchmarkThroughput(const char* name) {
+    Shaper shaper{0.0};
+    benchmark::measure(name, ITERATIONS, [&](const size_t& i) {
+        benchmark::doNotOptimize(shaper.convolute(double(i % 1000U), 0.001));
+    });
+}
+
+// Maximum error of a single float moving average against the exact mean of the window.
+template<typename Metrics>
+void benchmarkDrift(const char* name) {
+    MovingMetrics<float, WINDOW, Metrics> moving_metrics{0.0f};
+    Queue<float, WINDOW> window;
+    window.fill(0.0f);
+
+    double sum{0.0};
+    double max_error{0.0};
+    uint32_t seed{1U};
+    for(size_t i = 0; i < DRIFT_SAMPLES; i++) {
+        seed = seed * 1664525U + 1013904223U;
+        const float input = float(seed >> 8U) / float(1U << 24U) * 2000.0f - 1000.0f;
+        sum += double(input) - double(window.back());
+        window.push(input);
+
+        const double error = ::fabs(double(moving_metrics.convolute(input)) - sum / double(WINDOW));
+        max_error = error > max_error ? error : max_error;
+    }
+
+    printf("%-56s %10.3e max error after %zu samples\n", name, max_error, DRIFT_SAMPLES);
+}
+
+int main() {
+    printf("Recursive vs RunningSum metrics\n");
+    benchmarkThroughput<NestedShaperEuclideanRecursive<double, 5, 100, 50, 20>>("Recursive shaper (100, 50, 20)");
+    benchmarkThroughput<NestedShaperEuclideanRunningSum<double, 5, 100, 50, 20>>("RunningSum shaper (100, 50, 20)");
+    benchmarkDrift<EuclideanMeanRecursiveMetrics<float>>("Recursive float (100)");
+    benchmarkDrift<EuclideanMeanRunningSumMetrics<float>>("RunningSum float (100)");
+    return 0;
+}
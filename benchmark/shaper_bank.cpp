@@ -0,0 +1,49 @@
+// The stage loop of ShaperBank (ShaperBank::convoluteStage) is expected to be vectorized, check it with e.g.
+//   g++ -std=c++14 -O2 -mavx2 -fopt-info-vec -Iinclude -c benchmark/shaper_bank.cpp -o /dev/null
+// which should report "optimized: loop vectorized" for the loop of convoluteStage, without "versioned for vectorization".
+// GCC 12, -O3 -mavx2 : about 20 ns/channel with a branch in the loop, about 10 ~ 14 ns/channel vectorized.
+#include "benchmark.hpp"
+#include <nested-shaper/ShaperBank.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <vector>
+
+using namespace ns;
+
+constexpr size_t CHANNELS = 400U;
+constexpr size_t REPEATS = 2000U;
+
+using Shaper = NestedShaperEuclideanRecursive<double, 5, 40, 20, 10>;
+using Bank = ShaperBank<double, CHANNELS, 5, 40, 20, 10>;
+
+int main() {
+    static double inputs[CHANNELS];
+    for(size_t c = 0; c < CHANNELS; c++) {
+        inputs[c] = double(c % 13U);
+    }
+
+    printf("%zu independent shapers vs ShaperBank\n", CHANNELS);
+
+    std::vector<Shaper> shapers(CHANNELS, Shaper{0.0});
+    static array<double, 5> results[CHANNELS];
+    double ns = benchmark::measure("NestedShaperEuclideanRecursive x 400", REPEATS, [&](const size_t& i) {
+        for(size_t c = 0; c < CHANNELS; c++) {
+            results[c] = shapers[c].convolute(inputs[c] + double(i % 7U), 0.001);
+        }
+        benchmark::doNotOptimize(results[CHANNELS - 1U]);
+    });
+    printf("%-56s %10.3f ns/channel\n", "", ns / double(CHANNELS));
+
+    static Bank bank{0.0};
+    static double outputs[5][CHANNELS];
+    const DerivativeBuffers<double, 5> buffers{{outputs[0], outputs[1], outputs[2], outputs[3], outputs[4]}};
+    static double shifted[CHANNELS];
+    ns = benchmark::measure("ShaperBank<400>", REPEATS, [&](const size_t& i) {
+        for(size_t c = 0; c < CHANNELS; c++) {
+            shifted[c] = inputs[c] + double(i % 7U);
+        }
+        bank.convolute(shifted, 0.001, buffers);
+        benchmark::doNotOptimize(outputs[4][CHANNELS - 1U]);
+    });
+    printf("%-56s %10.3f ns/channel\n", "", ns / double(CHANNELS));
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "benchmark.hpp"
+#include <nested-shaper/NestedShaper.hpp>
+
+using namespace ns;
+
+constexpr size_t SAMPLES = 4096U;
+constexpr size_t REPEATS = 200U;
+
+template<typename Shaper>
+void benchmarkShaper(const char* name) {
+    static double input[SAMPLES];
+    for(size_t i = 0; i < SAMPLES; i++) {
+        input[i] = double(i % 1000U);
+    }
+
+    static Shaper shaper{0.0};
+    const double ns = benchmark::measure(name, REPEATS, [&](const size_t&) {
+        for(size_t i = 0; i < SAMPLES; i++) {
+            benchmark::doNotOptimize(shaper.convolute(input[i], 0.001));
+        }
+    });
+    printf("%-56s %10.3f ns/sample\n", "", ns / double(SAMPLES));
+}
+
+int main() {
+    printf("Derivative queue vs stage differences (position .. jerk, 3 stages)\n");
+    benchmarkShaper<NestedShaperEuclideanRecursiveFused<double, 4, 80, 40, 16>>("Recursive, derivative queue");
+    benchmarkShaper<NestedShaperEuclideanRecursiveStage<double, 4, 80, 40, 16>>("Recursive, stage differences");
+    return 0;
+}
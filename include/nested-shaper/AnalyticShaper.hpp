@@ -0,0 +1,277 @@
+/**
+ * @file AnalyticShaper.hpp
+ *
+ * @brief This file contains the definition of the AnalyticShaper class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for ns::array
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+/**
+ * @class AnalyticShaper
+ *
+ * Closed-form nested SMAs of a piecewise-polynomial reference, in continuous time (see theory.md).
+ * The reference is appended as segments, each is a polynomial of Degree from its start time.
+ * A segment starts a knot, the difference from the previous polynomial as truncated powers (t - t_k)_+^m.
+ * Nested SMAs of windows T_1 ... T_Stages map each truncated power to the alternating sum over subsets of windows, eq. (6).
+ *
+ * A knot is settled once t >= t_k + sum of windows, then the output is the filtered polynomial of its segment,
+ * which is computed once, instead of the alternating sums of large powers.
+ * evaluate returns the shaped position and derivatives at t exactly, in O(active knots * Degree * 2^Stages),
+ * where active knots are appended within the sum of windows. Time of evaluate should not decrease.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam N Number of results, position and N - 1 derivatives.
+ * @tparam Degree Maximum degree of polynomial segments.
+ * @tparam Knots Maximum number of active knots.
+ * @tparam Stages Number of nested SMAs.
+ */
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+class AnalyticShaper {
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    using polynomial_type = array<Type, Degree + 1U>; // coefficients of (t - t_k)^m
+    using derivative_type = array<Type, N>;
+    static constexpr size_type subsets = size_type(1U) << Stages;
+
+    /**
+     * Constructors
+     *
+     * windows : width of each SMA, in the same unit as time.
+     */
+    template<typename... Args>
+    explicit AnalyticShaper(const Type& value, const Args&... windows);
+
+    /**
+     * (Re)Initializers
+     *
+     * initialize : constant reference of given value, every knot is removed.
+     */
+    void initialize(const Type& value);
+
+    /**
+     * Append a segment, which starts at t.
+     * t should not be less than the start of the last segment.
+     * Returns false if the segment is invalid, or there are Knots active knots.
+     */
+    bool append(const Type& t, const polynomial_type& coefficients);
+
+    /**
+     * Shaped position and derivatives at t.
+     */
+    derivative_type evaluate(const Type& t);
+
+    /**
+     * Number of active knots
+     */
+    inline size_type size() const { return _size; }
+
+protected:
+    struct Knot {
+        Type time;            // start of the segment
+        polynomial_type jump; // difference from the previous segment, around time
+        polynomial_type raw;  // polynomial of the segment, around time
+    };
+
+    Type _windows[Stages]{};
+    Type _shifts[subsets]{}; // sum of windows of each subset
+    Type _signs[subsets]{};  // (-1)^(size of each subset)
+    Type _scale{Type(1)};    // 1 / product of windows
+    Type _settle{Type(0)};   // sum of windows
+
+    polynomial_type _filtered{}; // filtered polynomial of the settled segment, around _origin
+    Type _origin{Type(0)};
+
+    polynomial_type _last{}; // polynomial of the last segment, around _last_time
+    Type _last_time{Type(0)};
+    bool _started{false}; // any segment is appended since initialize
+
+    Knot _knots[Knots]{}; // ring of active knots
+    size_type _begin{0};
+    size_type _size{0};
+
+    polynomial_type filter(polynomial_type polynomial) const;
+    static polynomial_type shift(const polynomial_type& polynomial, const Type& h);
+    static derivative_type derivatives(const polynomial_type& polynomial, const Type& x);
+};
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+constexpr typename AnalyticShaper<Type, N, Degree, Knots, Stages>::size_type AnalyticShaper<Type, N, Degree, Knots, Stages>::subsets;
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+template<typename... Args>
+AnalyticShaper<Type, N, Degree, Knots, Stages>::AnalyticShaper(const Type& value, const Args&... windows) :
+_windows{static_cast<Type>(windows)...} {
+    static_assert(sizeof...(windows) == Stages, "Number of windows must be equal to number of stages.");
+    static_assert(Stages > 0 && Knots > 0, "Number of stages and knots must be greater than 0.");
+
+    for(size_type s = 0; s < Stages; ++s) {
+        assert(_windows[s] > Type(0));
+        _scale /= _windows[s];
+        _settle += _windows[s];
+    }
+
+    for(size_type i = 0; i < subsets; ++i) {
+        _shifts[i] = Type(0);
+        _signs[i] = Type(1);
+        for(size_type s = 0; s < Stages; ++s) {
+            if(i & (size_type(1U) << s)) {
+                _shifts[i] += _windows[s];
+                _signs[i] = -_signs[i];
+            }
+        }
+    }
+
+    initialize(value);
+}
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+void AnalyticShaper<Type, N, Degree, Knots, Stages>::initialize(const Type& value) {
+    for(size_type m = 0; m <= Degree; ++m) {
+        _filtered[m] = Type(0);
+        _last[m] = Type(0);
+    }
+
+    _filtered[0] = value;
+    _last[0] = value;
+    _origin = Type(0);
+    _last_time = Type(0);
+    _started = false;
+    _begin = 0;
+    _size = 0;
+}
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+bool AnalyticShaper<Type, N, Degree, Knots, Stages>::append(const Type& t, const polynomial_type& coefficients) {
+    if((_started && t < _last_time) || _size == Knots) {
+        assert(false);
+        return false;
+    }
+
+    const polynomial_type previous = shift(_last, t - _last_time);
+
+    Knot& knot = _knots[(_begin + _size) % Knots];
+    knot.time = t;
+    for(size_type m = 0; m <= Degree; ++m) {
+        knot.jump[m] = coefficients[m] - previous[m];
+        knot.raw[m] = coefficients[m];
+    }
+    ++_size;
+
+    _last = coefficients;
+    _last_time = t;
+    _started = true;
+    return true;
+}
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+typename AnalyticShaper<Type, N, Degree, Knots, Stages>::derivative_type AnalyticShaper<Type, N, Degree, Knots, Stages>::evaluate(const Type& t) {
+    // Settle knots, whose every shifted truncated power is positive.
+    while(_size > 0 && t >= _knots[_begin].time + _settle) {
+        _filtered = filter(_knots[_begin].raw);
+        _origin = _knots[_begin].time;
+        _begin = (_begin + 1U) % Knots;
+        --_size;
+    }
+
+    derivative_type result = derivatives(_filtered, t - _origin);
+
+    // x^q / q! for q up to Degree + Stages
+    Type powers[Degree + Stages + 1U];
+    for(size_type i = 0; i < _size; ++i) {
+        const Knot& knot = _knots[(_begin + i) % Knots];
+
+        for(size_type s = 0; s < subsets; ++s) {
+            const Type x = t - knot.time - _shifts[s];
+            if(x < Type(0)) {
+                continue;
+            }
+
+            powers[0] = Type(1);
+            for(size_type q = 1; q <= Degree + Stages; ++q) {
+                powers[q] = powers[q - 1U] * x / Type(q);
+            }
+
+            // m! (x)_+^(m + Stages) / (m + Stages)!, differentiated k times
+            Type factorial{Type(1)};
+            for(size_type m = 0; m <= Degree; ++m) {
+                factorial *= m > 0 ? Type(m) : Type(1);
+                const Type coefficient = _signs[s] * _scale * factorial * knot.jump[m];
+                for(size_type k = 0; k < N && k <= m + Stages; ++k) {
+                    result[k] += coefficient * powers[m + Stages - k];
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+typename AnalyticShaper<Type, N, Degree, Knots, Stages>::polynomial_type AnalyticShaper<Type, N, Degree, Knots, Stages>::filter(polynomial_type polynomial) const {
+    // SMA of a polynomial p, (P(x) - P(x - T)) / T = sum of (-1)^(j + 1) T^(j - 1) / j! p^(j - 1)(x), for j >= 1
+    for(size_type s = 0; s < Stages; ++s) {
+        polynomial_type result{};
+        polynomial_type derivative = polynomial; // p^(j - 1), as coefficients of x^m
+        Type scale{Type(1)};                     // (-1)^(j + 1) T^(j - 1) / j!
+        for(size_type j = 1; j <= Degree + 1U; ++j) {
+            scale /= Type(j);
+            for(size_type m = 0; m <= Degree; ++m) {
+                result[m] += scale * derivative[m];
+            }
+
+            for(size_type m = 0; m < Degree; ++m) {
+                derivative[m] = derivative[m + 1U] * Type(m + 1U);
+            }
+            derivative[Degree] = Type(0);
+            scale *= -_windows[s];
+        }
+
+        polynomial = result;
+    }
+
+    return polynomial;
+}
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+typename AnalyticShaper<Type, N, Degree, Knots, Stages>::polynomial_type AnalyticShaper<Type, N, Degree, Knots, Stages>::shift(const polynomial_type& polynomial, const Type& h) {
+    // Taylor shift by Horner, coefficients of (x - h)^m
+    polynomial_type result = polynomial;
+    for(size_type i = 0; i < Degree; ++i) {
+        for(size_type m = Degree - 1U; m + 1U > i; --m) {
+            result[m] += h * result[m + 1U];
+        }
+    }
+
+    return result;
+}
+
+template<typename Type, size_t N, size_t Degree, size_t Knots, size_t Stages>
+typename AnalyticShaper<Type, N, Degree, Knots, Stages>::derivative_type AnalyticShaper<Type, N, Degree, Knots, Stages>::derivatives(const polynomial_type& polynomial, const Type& x) {
+    derivative_type result{};
+    polynomial_type derivative = polynomial;
+    for(size_type k = 0; k < N; ++k) {
+        Type value{Type(0)};
+        for(size_type m = Degree + 1U; m-- > 0;) {
+            value = value * x + derivative[m];
+        }
+        result[k] = value;
+
+        for(size_type m = 0; m < Degree; ++m) {
+            derivative[m] = derivative[m + 1U] * Type(m + 1U);
+        }
+        derivative[Degree] = Type(0);
+    }
+
+    return result;
+}
+
+}; // namespace ns
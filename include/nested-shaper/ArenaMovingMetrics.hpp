@@ -0,0 +1,210 @@
+/**
+ * @file ArenaMovingMetrics.hpp
+ *
+ * @brief This file contains the definition of the ArenaMovingMetrics class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "ArenaQueue.hpp"
+#include "MovingMetrics.hpp" // for ns::initialize_metrics, ns::convolute_box
+
+namespace ns {
+/**
+ * @class ArenaMovingMetrics
+ *
+ * MovingMetrics with runtime extent, samples are stored in an ArenaQueue.
+ * Extent is given at construction and the storage is allocated from the arena,
+ * so capacity may be changed by initialize up to the extent.
+ *
+ * Metrics functor is the same as MovingMetrics, iterators are QueueConstIterator<Type>.
+ *
+ * If the arena is exhausted, the moving metrics is not valid(), and refuses to run :
+ * convolute returns the value of initialize, without touching the storage.
+ */
+template<typename Type, typename Metrics>
+class ArenaMovingMetrics : protected ArenaQueue<Type> {
+public:
+    using value_type = Type;
+    using reference = Type&;
+    using const_reference = const Type&;
+    using size_type = size_t;
+
+    /**
+     * Constructors
+     */
+    explicit ArenaMovingMetrics(const Type& value, Arena<Type>& arena, const size_type& extent_) :
+    ArenaQueue<Type>(arena, extent_) { initialize(value); };
+
+    /**
+     * Status of the queue
+     */
+    using ArenaQueue<Type>::valid;
+    using ArenaQueue<Type>::extent;
+    using ArenaQueue<Type>::capacity;
+
+    /**
+     * (Re)Initializers
+     *
+     * initialize : fill the queue with given value.
+     */
+    void initialize(const Type& value);
+    void initialize(const Type& value, const size_type& capacity_);
+
+    /**
+     * Convolute
+     *
+     * given value is convoluted with the metrics.
+     * returns the convoluted value.
+     */
+    Type convolute(const Type& value);
+
+    /**
+     * Convolute a block of n samples, same as n calls of convolute.
+     * output may be the same as input.
+     */
+    void convoluteBlock(const Type* input, Type* output, const size_type& n);
+
+protected:
+    Type mean{};       // Mean(average) value
+    Metrics metrics{}; // Metrics functor
+
+    using ArenaQueue<Type>::fill;
+};
+
+template<typename Type, typename Metrics>
+void ArenaMovingMetrics<Type, Metrics>::initialize(const Type& value) {
+    mean = value;
+    if(!valid()) {
+        return;
+    }
+
+    metrics = Metrics{};
+    initialize_metrics(metrics, value, capacity(), 0);
+    fill(value);
+};
+
+template<typename Type, typename Metrics>
+void ArenaMovingMetrics<Type, Metrics>::initialize(const Type& value, const size_type& capacity_) {
+    if(valid()) {
+        ArenaQueue<Type>::resize(capacity_);
+    }
+
+    initialize(value);
+};
+
+template<typename Type, typename Metrics>
+Type ArenaMovingMetrics<Type, Metrics>::convolute(const Type& value) {
+    if(!valid()) {
+        return mean;
+    }
+
+    const Type popped = ArenaQueue<Type>::shift(value); // iterators must be created after shift
+    mean = metrics.template
+           operator()(mean,
+                      popped,
+                      value,
+                      ArenaQueue<Type>::forwardConstIterator(),
+                      ArenaQueue<Type>::backwardConstIterator());
+    return mean;
+};
+
+template<typename Type, typename Metrics>
+void ArenaMovingMetrics<Type, Metrics>::convoluteBlock(const Type* input, Type* output, const size_type& n) {
+    for(size_type i = 0; i < n; ++i) {
+        output[i] = convolute(input[i]);
+    }
+};
+
+/**
+ * Nested ArenaMovingMetrics, the number of stages is fixed and extents are given at construction.
+ * Every stage is allocated from the same arena, Arena<Type>::required(extents...) elements in total.
+ * Interface is the same as BasicMovingMetricsNested, so it can be used as Nested of BasicShaperMetrics.
+ * valid() is false if any stage could not be allocated, and such stages hold the initial value.
+ */
+template<typename Type, typename Metrics, size_t Stages>
+struct ArenaMovingMetricsNested {
+    static_assert(Stages > 0, "Number of stages must be greater than 0.");
+
+    template<typename... Args>
+    explicit ArenaMovingMetricsNested(const Type& value, Arena<Type>& arena, const size_t& extent, const Args&... extents) :
+    moving_metrics(value, arena, extent), moving_metrics_nested(value, arena, extents...) {
+        static_assert(sizeof...(extents) == Stages - 1U, "Number of extents must be equal to number of stages.");
+    }
+
+    inline bool valid() const {
+        return moving_metrics.valid() && moving_metrics_nested.valid();
+    }
+
+    inline void initialize(const Type& value) {
+        moving_metrics.initialize(value);
+        moving_metrics_nested.initialize(value);
+    }
+
+    template<typename... Args>
+    inline void initialize(const Type& value, const size_t& capacity, const Args&... capacities) {
+        static_assert(sizeof...(capacities) == Stages - 1U, "Number of capacities must be equal to number of stages.");
+        moving_metrics.initialize(value, capacity);
+        moving_metrics_nested.initialize(value, capacities...);
+    }
+
+    inline Type convolute(const Type& value) {
+        return moving_metrics_nested.convolute(moving_metrics.convolute(value));
+    }
+
+    inline void convoluteBlock(const Type* input, Type* output, const size_t& n) {
+        moving_metrics.convoluteBlock(input, output, n);
+        moving_metrics_nested.convoluteBlock(output, output, n);
+    }
+
+    // Composite kernel, same as BasicMovingMetricsNested, valid() should be true.
+    inline size_t kernelSize() const {
+        return moving_metrics.capacity() - 1U + moving_metrics_nested.kernelSize();
+    }
+
+    inline size_t convoluteKernel(Type* kernel, const size_t& size) const {
+        return moving_metrics_nested.convoluteKernel(kernel, convolute_box(kernel, size, moving_metrics.capacity()));
+    }
+
+    ArenaMovingMetrics<Type, Metrics> moving_metrics;
+    ArenaMovingMetricsNested<Type, Metrics, Stages - 1U> moving_metrics_nested;
+};
+
+template<typename Type, typename Metrics>
+struct ArenaMovingMetricsNested<Type, Metrics, 1> {
+    explicit ArenaMovingMetricsNested(const Type& value, Arena<Type>& arena, const size_t& extent) :
+    moving_metrics(value, arena, extent) {}
+
+    inline bool valid() const {
+        return moving_metrics.valid();
+    }
+
+    inline void initialize(const Type& value) {
+        moving_metrics.initialize(value);
+    };
+
+    inline void initialize(const Type& value, const size_t& capacity) {
+        moving_metrics.initialize(value, capacity);
+    };
+
+    inline Type convolute(const Type& value) {
+        return moving_metrics.convolute(value);
+    };
+
+    inline void convoluteBlock(const Type* input, Type* output, const size_t& n) {
+        moving_metrics.convoluteBlock(input, output, n);
+    };
+
+    inline size_t kernelSize() const {
+        return moving_metrics.capacity();
+    };
+
+    inline size_t convoluteKernel(Type* kernel, const size_t& size) const {
+        return convolute_box(kernel, size, moving_metrics.capacity());
+    };
+
+    ArenaMovingMetrics<Type, Metrics> moving_metrics;
+};
+}; // namespace ns
@@ -0,0 +1,142 @@
+/**
+ * @file ArenaQueue.hpp
+ *
+ * @brief This file contains the definition of the Arena and ArenaQueue classes.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "Queue.hpp" // for ns::QueueIterator, ns::QueueConstIterator
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+/**
+ * @class Arena
+ *
+ * A bump allocator over caller-provided storage.
+ * Arena does not own the storage, which must outlive every queue allocated from it.
+ * Allocations are released all at once by reset.
+ *
+ * @tparam Type Type of the elements.
+ */
+template<typename Type>
+class Arena {
+public:
+    using value_type = Type;
+    using size_type = size_t;
+
+    /**
+     * Constructors
+     */
+    explicit Arena(Type* data, const size_type& size) :
+    _data(data), _size(size) {}
+    template<size_t N>
+    explicit Arena(Type (&data)[N]) :
+    _data(data), _size(N) {}
+
+    /**
+     * Status of the arena
+     */
+    inline size_type size() const { return _size; }
+    inline size_type used() const { return _used; }
+    inline size_type remaining() const { return _size - _used; }
+
+    /**
+     * Number of elements required for the given capacities.
+     */
+    static constexpr size_type required() { return 0; }
+    template<typename... Args>
+    static constexpr size_type required(const size_type& capacity, const Args&... capacities) { return capacity + required(capacities...); }
+
+    /**
+     * Returns n contiguous elements, or nullptr if the arena is exhausted.
+     * Extents may come from a configuration at runtime, so exhaustion is reported to the caller instead of asserted.
+     */
+    Type* allocate(const size_type& n);
+
+    /**
+     * Release every allocation.
+     */
+    inline void reset() { _used = 0; }
+
+protected:
+    Type* const _data;     // caller-provided storage
+    const size_type _size; // number of elements of the storage
+    size_type _used{0};    // number of allocated elements
+};
+
+template<typename Type>
+Type* Arena<Type>::allocate(const size_type& n) {
+    if(n > remaining()) {
+        return nullptr;
+    }
+
+    Type* const result = _data + _used;
+    _used += n;
+    return result;
+}
+
+/**
+ * @class ArenaQueue
+ *
+ * A queue class with runtime extent, interchangeable with Queue.
+ * Samples are stored in caller-provided storage (usually allocated from an Arena) instead of an embedded array.
+ * Index logic and iterators are the same as Queue, so the metrics functors accept ArenaQueue unchanged.
+ *
+ * A queue without storage (default constructed, or bound to an exhausted arena) is not valid(),
+ * and must not be used until bound to storage.
+ *
+ * @tparam Type Type of the elements.
+ */
+template<typename Type>
+class ArenaQueue : public Queue<Type, dynamic_extent> {
+    using Base = Queue<Type, dynamic_extent>;
+
+public:
+    using typename Base::value_type;
+    using typename Base::size_type;
+
+    /**
+     * Constructors
+     *
+     * Default constructed queue has no storage, and must be bound before use.
+     */
+    ArenaQueue() = default;
+    explicit ArenaQueue(Type* data, const size_type& extent_) { bind(data, extent_); }
+    explicit ArenaQueue(Arena<Type>& arena, const size_type& extent_) { bind(arena, extent_); }
+    ArenaQueue(const ArenaQueue&) = delete; // copies would share the storage
+    ArenaQueue& operator=(const ArenaQueue&) = delete;
+
+    /**
+     * Bind to storage of extent elements, capacity is set to extent.
+     * Returns false if data is nullptr (e.g. the arena is exhausted), the queue is left without storage.
+     */
+    bool bind(Type* data, const size_type& extent_);
+    inline bool bind(Arena<Type>& arena, const size_type& extent_) { return bind(arena.allocate(extent_), extent_); }
+
+    /**
+     * Status of the queue
+     */
+    inline bool valid() const { return _data != nullptr; }
+    inline size_type extent() const { return _extent; }
+
+protected:
+    using Base::_data;
+    using Base::_extent;
+    using Base::_capacity;
+};
+
+template<typename Type>
+bool ArenaQueue<Type>::bind(Type* data, const size_type& extent_) {
+    _data = data;
+    _extent = data == nullptr ? 0 : extent_;
+    _capacity = _extent;
+    Base::reset();
+    return valid();
+}
+
+}; // namespace ns
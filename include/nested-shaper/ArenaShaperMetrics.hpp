@@ -0,0 +1,35 @@
+/**
+ * @file ArenaShaperMetrics.hpp
+ * 
+ * @brief This file contains the definition of the ArenaShaperMetrics class.
+ * 
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "ShaperMetrics.hpp"
+#include "ArenaMovingMetrics.hpp"
+
+namespace ns {
+/**
+ * ShaperMetrics with runtime extents of moving metrics, allocated from an arena.
+ * Constructed as ArenaShaperMetrics{value, arena, extents...}, requires Arena<Type>::required(extents...) elements.
+ * valid() should be checked after construction, as the arena may be exhausted by extents given at runtime.
+ * Otherwise moving metrics refuse to run, and convolute holds the value of initialize.
+ */
+template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t Stages>
+class ArenaShaperMetrics : public BasicShaperMetrics<Type, DerivativeMetrics, Queue<Type, Extent>, ArenaMovingMetricsNested<Type, MeanMetrics, Stages>> {
+    using Base = BasicShaperMetrics<Type, DerivativeMetrics, Queue<Type, Extent>, ArenaMovingMetricsNested<Type, MeanMetrics, Stages>>;
+    using Nested = ArenaMovingMetricsNested<Type, MeanMetrics, Stages>;
+
+public:
+    using Base::Base;
+
+    /**
+     * Every stage is allocated from the arena.
+     */
+    inline bool valid() const { return Nested::valid(); }
+};
+}; // namespace ns
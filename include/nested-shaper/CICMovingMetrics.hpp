@@ -0,0 +1,157 @@
+/**
+ * @file CICMovingMetrics.hpp
+ *
+ * @brief This file contains the definition of the CICMovingMetricsNested class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for ns::sum_of, ns::divide_rounded
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+namespace ns {
+/**
+ * @class CICMovingMetricsNested
+ *
+ * Nested moving averages of integer samples as a cascaded integrator-comb (CIC) filter.
+ * Samples go through one integrator per stage, then one comb per stage whose delay is the capacity of the stage.
+ * Integrators and combs wrap around in unsigned 64 bits, so the output is exact over unbounded runtimes
+ * as long as product of capacities * |sample - initial value| is less than 2^63.
+ * The output is the sum of the composite kernel divided by product of capacities, rounded once to nearest.
+ *
+ * Interface is the same as BasicMovingMetricsNested, so it can be used as Nested of BasicShaperMetrics.
+ *
+ * @tparam Type Type of the elements, an integer type up to 64 bits.
+ * @tparam Extent, Extents Maximum extent (comb delay) of each stage.
+ */
+template<typename Type, size_t Extent, size_t... Extents>
+class CICMovingMetricsNested {
+    static_assert(Type(1) / Type(2) == Type(0), "CICMovingMetricsNested requires integer samples.");
+
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    static constexpr size_type stages = 1U + sizeof...(Extents);
+    static constexpr size_type extents[stages] = {Extent, Extents...};
+
+    /**
+     * Constructors
+     */
+    explicit CICMovingMetricsNested(const Type& value) { initialize(value); }
+    template<typename... Args>
+    explicit CICMovingMetricsNested(const Type& value, const Args&... capacities) { initialize(value, capacities...); }
+
+    /**
+     * Capacity of the given stage
+     */
+    inline size_type capacity(const size_type& stage) const { return _capacities[stage]; }
+
+    /**
+     * (Re)Initializers
+     *
+     * initialize : as every stage is filled with given value.
+     */
+    void initialize(const Type& value);
+    template<typename... Args>
+    void initialize(const Type& value, const Args&... capacities);
+
+    /**
+     * Convolute
+     *
+     * given value is convoluted through every stage.
+     * output of convoluteBlock may be the same as input.
+     */
+    Type convolute(const Type& value);
+    void convoluteBlock(const Type* input, Type* output, const size_type& n);
+
+protected:
+    // Samples are relative to the initial value, so the history of every stage is zero.
+    Type _value{};                                     // initial value
+    int64_t _gain{1};                                  // product of capacities
+    uint64_t _integrators[stages]{};                   // integrator of each stage
+    size_type _backs[stages]{};                        // old index of each comb
+    size_type _capacities[stages]{Extent, Extents...}; // delay of each comb
+
+    // Delay lines of combs, the line of stage s starts after extents of stages before s.
+    uint64_t _delays[sum_of(Extent, Extents...)]{};
+};
+
+template<typename Type, size_t Extent, size_t... Extents>
+constexpr typename CICMovingMetricsNested<Type, Extent, Extents...>::size_type CICMovingMetricsNested<Type, Extent, Extents...>::stages;
+template<typename Type, size_t Extent, size_t... Extents>
+constexpr typename CICMovingMetricsNested<Type, Extent, Extents...>::size_type CICMovingMetricsNested<Type, Extent, Extents...>::extents[stages];
+
+template<typename Type, size_t Extent, size_t... Extents>
+void CICMovingMetricsNested<Type, Extent, Extents...>::initialize(const Type& value) {
+    _value = value;
+    _gain = 1;
+
+    uint64_t* delay = _delays;
+    for(size_type s = 0; s < stages; ++s) {
+        _gain *= int64_t(_capacities[s]);
+        _integrators[s] = 0;
+        _backs[s] = 0;
+
+        for(size_type i = 0; i < _capacities[s]; ++i) {
+            delay[i] = 0;
+        }
+
+        delay += extents[s];
+    }
+}
+
+template<typename Type, size_t Extent, size_t... Extents>
+template<typename... Args>
+void CICMovingMetricsNested<Type, Extent, Extents...>::initialize(const Type& value, const Args&... capacities) {
+    static_assert(sizeof...(capacities) == stages, "Number of capacities must be equal to number of extents.");
+    const size_type capacities_[stages] = {static_cast<size_type>(capacities)...};
+
+    for(size_type s = 0; s < stages; ++s) {
+        if(capacities_[s] > extents[s] || capacities_[s] == 0) {
+            assert(false);
+            _capacities[s] = extents[s];
+            continue;
+        }
+
+        _capacities[s] = capacities_[s];
+    }
+
+    initialize(value);
+}
+
+template<typename Type, size_t Extent, size_t... Extents>
+Type CICMovingMetricsNested<Type, Extent, Extents...>::convolute(const Type& value) {
+    uint64_t x = uint64_t(int64_t(value) - int64_t(_value));
+
+    for(size_type s = 0; s < stages; ++s) {
+        _integrators[s] += x;
+        x = _integrators[s];
+    }
+
+    uint64_t* delay = _delays;
+    for(size_type s = 0; s < stages; ++s) {
+        size_type& back = _backs[s];
+        const uint64_t delayed = delay[back];
+        delay[back] = x;
+        x -= delayed;
+
+        back == _capacities[s] - 1U ? back = 0 : back++;
+        delay += extents[s];
+    }
+
+    return Type(divide_rounded(int64_t(x), _gain) + int64_t(_value));
+}
+
+template<typename Type, size_t Extent, size_t... Extents>
+void CICMovingMetricsNested<Type, Extent, Extents...>::convoluteBlock(const Type* input, Type* output, const size_type& n) {
+    for(size_type i = 0; i < n; ++i) {
+        output[i] = convolute(input[i]);
+    }
+}
+
+}; // namespace ns
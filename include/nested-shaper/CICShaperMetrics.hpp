@@ -0,0 +1,22 @@
+/**
+ * @file CICShaperMetrics.hpp
+ * 
+ * @brief This file contains the definition of the CICShaperMetrics alias.
+ * 
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "ShaperMetrics.hpp"
+#include "CICMovingMetrics.hpp"
+
+namespace ns {
+/**
+ * ShaperMetrics of integer samples, with nested moving averages as a CIC filter.
+ * kernel is not available, as coefficients of the composite kernel are not integers.
+ */
+template<typename Type, typename DerivativeMetrics, size_t Extent, size_t... Extents>
+using CICShaperMetrics = BasicShaperMetrics<Type, DerivativeMetrics, Queue<Type, Extent>, CICMovingMetricsNested<Type, Extents...>>;
+}; // namespace ns
@@ -0,0 +1,40 @@
+/**
+ * @file FixedDtShaperMetrics.hpp
+ * 
+ * @brief This file contains the definition of the FixedDtShaperMetrics class.
+ * 
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "ShaperMetrics.hpp"
+
+namespace ns {
+/**
+ * ShaperMetrics with DerivativeMetrics for a fixed time step, e.g. EuclideanDerivativeFixedDtMetrics.
+ * Constructed as FixedDtShaperMetrics{value, dt, capacities...} and reinitialized by initialize(value, dt, capacities...),
+ * which pass dt to initialize(dt) of DerivativeMetrics, so coefficients can not be left unscaled.
+ * convolute and evaluate should be given the same dt.
+ */
+template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+class FixedDtShaperMetrics : public ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...> {
+    using Base = ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>;
+
+public:
+    using time_type = typename DerivativeMetrics::time_type;
+
+    template<typename... Args>
+    explicit FixedDtShaperMetrics(const Type& value, const time_type& dt, Args&&... capacities) :
+    Base(value, static_cast<Args&&>(capacities)...) {
+        Base::derivative_metrics.initialize(dt);
+    }
+
+    template<typename... Args>
+    void initialize(const Type& value, const time_type& dt, const Args&... capacities) {
+        Base::initialize(value, capacities...);
+        Base::derivative_metrics.initialize(dt);
+    }
+};
+}; // namespace ns
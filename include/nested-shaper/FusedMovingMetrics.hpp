@@ -0,0 +1,190 @@
+/**
+ * @file FusedMovingMetrics.hpp
+ *
+ * @brief This file contains the definition of the FusedMovingMetricsNested class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "MovingMetrics.hpp" // for ns::QueueConstIterator, ns::initialize_metrics, ns::convolute_box
+#include "tiny_utility.hpp"  // for ns::sum_of, NESTED_SHAPER_CACHE_LINE_SIZE
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+/**
+ * @class FusedMovingMetricsNested
+ *
+ * Flattened form of MovingMetricsNested, with the same results and the same interface.
+ * Means, metrics functors (with their compensation terms) and ring indices of every stage are packed together,
+ * followed by the rings of every stage in a single array. The state is aligned to a cache line.
+ * convolute updates every stage in a single loop, instead of a recursive chain of MovingMetrics.
+ *
+ * Metrics functor is the same as MovingMetrics, iterators are QueueConstIterator<Type>.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam Metrics Metrics functor of every stage.
+ * @tparam Extent, Extents Maximum extent of each stage.
+ */
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+class alignas(NESTED_SHAPER_CACHE_LINE_SIZE) FusedMovingMetricsNested {
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    static constexpr size_type stages = 1U + sizeof...(Extents);
+    static constexpr size_type extents[stages] = {Extent, Extents...};
+
+    /**
+     * Constructors
+     */
+    explicit FusedMovingMetricsNested(const Type& value) { initialize(value); }
+    template<typename... Args>
+    explicit FusedMovingMetricsNested(const Type& value, const Args&... capacities) { initialize(value, capacities...); }
+
+    /**
+     * Capacity of the given stage
+     */
+    inline size_type capacity(const size_type& stage) const { return _capacities[stage]; }
+
+    /**
+     * (Re)Initializers
+     *
+     * initialize : fill every stage with given value.
+     */
+    void initialize(const Type& value);
+    template<typename... Args>
+    void initialize(const Type& value, const Args&... capacities);
+
+    /**
+     * Convolute
+     *
+     * given value is convoluted through every stage.
+     * convoluteBlock runs stage by stage over the block, output may be the same as input.
+     */
+    Type convolute(Type value);
+    void convoluteBlock(const Type* input, Type* output, const size_type& n);
+
+    /**
+     * Composite kernel, same as BasicMovingMetricsNested.
+     */
+    size_type kernelSize() const;
+    size_type convoluteKernel(Type* kernel, size_type size) const;
+
+protected:
+    // Per stage state, accessed on every convolute.
+    Type _means[stages]{};                             // Mean(average) value
+    Metrics _metrics[stages]{};                        // Metrics functor
+    size_type _backs[stages]{};                        // old index of the ring
+    size_type _capacities[stages]{Extent, Extents...}; // size of the ring
+
+    // Rings of every stage, the ring of stage s starts after extents of stages before s.
+    Type _data[sum_of(Extent, Extents...)]{};
+
+    inline Type convoluteStage(const size_type& stage, Type* ring, const Type& value);
+};
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+constexpr typename FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::size_type FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::stages;
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+constexpr typename FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::size_type FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::extents[stages];
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+void FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::initialize(const Type& value) {
+    Type* ring = _data;
+    for(size_type s = 0; s < stages; ++s) {
+        _means[s] = value;
+        _metrics[s] = Metrics{};
+        initialize_metrics(_metrics[s], value, _capacities[s], 0);
+        _backs[s] = 0;
+
+        for(size_type i = 0; i < _capacities[s]; ++i) {
+            ring[i] = value;
+        }
+
+        ring += extents[s];
+    }
+}
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+template<typename... Args>
+void FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::initialize(const Type& value, const Args&... capacities) {
+    static_assert(sizeof...(capacities) == stages, "Number of capacities must be equal to number of extents.");
+    const size_type capacities_[stages] = {static_cast<size_type>(capacities)...};
+
+    for(size_type s = 0; s < stages; ++s) {
+        if(capacities_[s] > extents[s]) {
+            assert(false);
+            _capacities[s] = extents[s];
+            continue;
+        }
+
+        _capacities[s] = capacities_[s];
+    }
+
+    initialize(value);
+}
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+Type FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::convoluteStage(const size_type& stage, Type* ring, const Type& value) {
+    const size_type capacity = _capacities[stage];
+    const size_type front = _backs[stage]; // the oldest sample is replaced by the most recent one
+    const Type popped = ring[front];
+    ring[front] = value;
+
+    size_type& back = _backs[stage];
+    back == capacity - 1U ? back = 0 : back++;
+
+    _means[stage] = _metrics[stage].template operator()(_means[stage],
+                                                        popped,
+                                                        value,
+                                                        QueueConstIterator<Type>(capacity, ring + back, ring, ring + capacity),
+                                                        QueueConstIterator<Type>(capacity, ring + front, ring, ring + capacity));
+    return _means[stage];
+}
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+Type FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::convolute(Type value) {
+    Type* ring = _data;
+    for(size_type s = 0; s < stages; ++s) {
+        value = convoluteStage(s, ring, value);
+        ring += extents[s];
+    }
+
+    return value;
+}
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+void FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::convoluteBlock(const Type* input, Type* output, const size_type& n) {
+    Type* ring = _data;
+    for(size_type s = 0; s < stages; ++s) {
+        for(size_type i = 0; i < n; ++i) {
+            output[i] = convoluteStage(s, ring, input[i]);
+        }
+
+        input = output;
+        ring += extents[s];
+    }
+}
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+typename FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::size_type FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::kernelSize() const {
+    size_type size{1};
+    for(size_type s = 0; s < stages; ++s) {
+        size += _capacities[s] - 1U;
+    }
+
+    return size;
+}
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+typename FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::size_type FusedMovingMetricsNested<Type, Metrics, Extent, Extents...>::convoluteKernel(Type* kernel, size_type size) const {
+    for(size_type s = 0; s < stages; ++s) {
+        size = convolute_box(kernel, size, _capacities[s]);
+    }
+
+    return size;
+}
+}; // namespace ns
@@ -0,0 +1,21 @@
+/**
+ * @file FusedShaperMetrics.hpp
+ * 
+ * @brief This file contains the definition of the FusedShaperMetrics alias.
+ * 
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "ShaperMetrics.hpp"
+#include "FusedMovingMetrics.hpp"
+
+namespace ns {
+/**
+ * ShaperMetrics with fused moving metrics, same results with ShaperMetrics.
+ */
+template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+using FusedShaperMetrics = BasicShaperMetrics<Type, DerivativeMetrics, Queue<Type, Extent>, FusedMovingMetricsNested<Type, MeanMetrics, Extents...>>;
+}; // namespace ns
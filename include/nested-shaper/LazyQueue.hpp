@@ -0,0 +1,296 @@
+/**
+ * @file LazyQueue.hpp
+ *
+ * @brief This file contains the definition of the LazyQueue class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+template<typename Type>
+struct LazyQueueConstIterator;
+
+/**
+ * @class LazyQueue
+ *
+ * A template based queue class, interchangeable with Queue.
+ * fill does not write the storage, the queue remembers the value and the number of virtual elements instead.
+ * Virtual elements are always the oldest ones, and are replaced one by one as new elements are pushed.
+ * Therefore fill (and initialize of MovingMetrics) is O(1), while the elements are the same as Queue.
+ *
+ * Accessors return elements by value, as virtual elements are not stored.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam Extent Maximum extent of the queue.
+ */
+template<typename Type, size_t Extent>
+class LazyQueue {
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    static constexpr size_type extent = Extent;
+
+    template<typename _Type>
+    friend struct LazyQueueConstIterator;
+
+    /**
+     * Constructors
+     */
+    LazyQueue();
+    explicit LazyQueue(const size_type& capacity);
+
+    /**
+     * Status of the queue
+     *
+     * lazy : number of virtual elements, which are not written to the storage yet.
+     */
+    inline bool isEmpty() const { return _size == 0; }
+    inline bool isFull() const { return _size == _capacity; }
+    inline size_type capacity() const { return _capacity; }
+    inline size_type size() const { return _size; }
+    inline size_type lazy() const { return _lazy; }
+
+    /**
+     * Accessors
+     *
+     * front : retrieve from the most recent index
+     * back : retrieve from the most old index
+     */
+    value_type front(const size_type& index = 0) const;
+    value_type back(const size_type& index = 0) const;
+
+    /**
+     * reset : Set queue as empty
+     * resize : Set capacity of queue
+     */
+    void reset();
+    void resize(const size_type& size);
+
+    /**
+     * Pop and Push
+     */
+    void pop();
+    void push(const value_type& value);
+
+    /**
+     * Push to a full queue, and returns the popped value.
+     * Does not check about queue size.
+     */
+    value_type shift(const value_type& value);
+
+    /**
+     * Fill the queue with given value, without writing the storage.
+     */
+    void fill(const value_type& value);
+
+    /**
+     * Iterators
+     *
+     * Warnings :
+     * forwardIterator should use ++ or + operator.
+     * backwardIterator should use -- or - operator.
+     */
+    inline LazyQueueConstIterator<Type> forwardConstIterator() const { return LazyQueueConstIterator<Type>{*this, _back, 0}; }
+    inline LazyQueueConstIterator<Type> backwardConstIterator() const { return LazyQueueConstIterator<Type>{*this, _front, _size - 1U}; }
+
+protected:
+    value_type _data[Extent]{};
+    value_type _value{};              // value of virtual elements
+    size_type _capacity;              // maximum size
+    size_type _size{0};               // current size
+    size_type _lazy{0};               // number of virtual elements, from the most old
+    size_type _back{0};               // old index
+    size_type _front{_capacity - 1U}; // recent index
+
+    inline size_type index(const size_type& offset) const {
+        return (_back + offset >= _capacity) ? _back + offset - _capacity : _back + offset;
+    }
+};
+
+template<typename Type, size_t Extent>
+constexpr typename LazyQueue<Type, Extent>::size_type LazyQueue<Type, Extent>::extent;
+
+template<typename Type, size_t Extent>
+LazyQueue<Type, Extent>::LazyQueue() :
+_capacity(Extent) {}
+
+template<typename Type, size_t Extent>
+LazyQueue<Type, Extent>::LazyQueue(const size_type& capacity) :
+_capacity(capacity) {
+    assert(capacity <= Extent);
+}
+
+template<typename Type, size_t Extent>
+typename LazyQueue<Type, Extent>::value_type LazyQueue<Type, Extent>::front(const size_type& index_) const {
+    if(index_ >= _size) {
+        assert(false);
+        return back();
+    }
+
+    return back(_size - 1U - index_);
+}
+
+template<typename Type, size_t Extent>
+typename LazyQueue<Type, Extent>::value_type LazyQueue<Type, Extent>::back(const size_type& index_) const {
+    if(index_ >= _size) {
+        assert(false);
+        return _lazy > 0 ? _value : _data[_front];
+    }
+
+    return index_ < _lazy ? _value : _data[index(index_)];
+}
+
+template<typename Type, size_t Extent>
+void LazyQueue<Type, Extent>::reset() {
+    _size = 0;
+    _lazy = 0;
+    _back = 0;
+    _front = _capacity - 1U;
+}
+
+template<typename Type, size_t Extent>
+void LazyQueue<Type, Extent>::resize(const size_type& size) {
+    if(size > Extent) {
+        assert(false);
+        resize(Extent);
+        return;
+    }
+
+    if(size == _capacity) {
+        return;
+    }
+
+    _capacity = size;
+    reset();
+}
+
+template<typename Type, size_t Extent>
+void LazyQueue<Type, Extent>::pop() {
+    if(isEmpty()) {
+        assert(false);
+        return;
+    }
+
+    if(_lazy > 0) {
+        --_lazy;
+    }
+
+    --_size;
+    _back == _capacity - 1U ? _back = 0 : _back++;
+}
+
+template<typename Type, size_t Extent>
+void LazyQueue<Type, Extent>::push(const value_type& value) {
+    if(isFull()) {
+        pop();
+    }
+
+    ++_size;
+    _front == _capacity - 1U ? _front = 0 : _front++;
+    _data[_front] = value;
+}
+
+template<typename Type, size_t Extent>
+typename LazyQueue<Type, Extent>::value_type LazyQueue<Type, Extent>::shift(const value_type& value) {
+    value_type result;
+    if(_lazy > 0) {
+        --_lazy;
+        result = _value;
+    } else {
+        result = _data[_back];
+    }
+
+    _back == _capacity - 1U ? _back = 0 : _back++;
+    _front == _capacity - 1U ? _front = 0 : _front++;
+    _data[_front] = value;
+    return result;
+}
+
+template<typename Type, size_t Extent>
+void LazyQueue<Type, Extent>::fill(const value_type& value) {
+    _value = value;
+    _size = _capacity;
+    _lazy = _capacity;
+    _back = 0;
+    _front = _capacity - 1U;
+}
+
+/**
+ * Const iterator of lazy queue.
+ * Keeps the offset from the most old element, to tell virtual elements from stored ones.
+ */
+template<typename Type>
+struct LazyQueueConstIterator {
+    template<size_t Extent>
+    explicit LazyQueueConstIterator(const LazyQueue<Type, Extent>& queue, const size_t& index, const size_t& _offset) :
+    size(queue._size), ptr(queue._data + index), pBegin(queue._data), pEnd(queue._data + queue._capacity), value(&queue._value), lazy(queue._lazy), offset(_offset) {}
+    LazyQueueConstIterator(const LazyQueueConstIterator&) = default;
+    LazyQueueConstIterator(const LazyQueueConstIterator<Type>& other, const Type* _ptr, const size_t& _offset) :
+    size(other.size), ptr(_ptr), pBegin(other.pBegin), pEnd(other.pEnd), value(other.value), lazy(other.lazy), offset(_offset) {}
+
+    inline const Type& operator*() const { return offset < lazy ? *value : *ptr; }
+
+    inline LazyQueueConstIterator& operator++() {
+        if(++ptr == pEnd) {
+            ptr = pBegin;
+        }
+
+        ++offset;
+        return *this;
+    }
+    inline LazyQueueConstIterator operator++(int) {
+        LazyQueueConstIterator tmp(*this);
+        operator++();
+        return tmp;
+    }
+    inline LazyQueueConstIterator& operator--() {
+        if(--ptr < pBegin) {
+            ptr = pEnd - 1U;
+        }
+
+        --offset;
+        return *this;
+    }
+    inline LazyQueueConstIterator operator--(int) {
+        LazyQueueConstIterator tmp(*this);
+        operator--();
+        return tmp;
+    }
+
+    inline LazyQueueConstIterator operator+(const size_t& n) const {
+        return LazyQueueConstIterator{*this, (ptr + n >= pEnd) ? pBegin + (ptr + n - pEnd) : ptr + n, offset + n};
+    }
+    inline void operator+=(const size_t& n) {
+        ptr = (ptr + n >= pEnd) ? pBegin + (ptr + n - pEnd) : ptr + n;
+        offset += n;
+    }
+    inline LazyQueueConstIterator operator-(const size_t& n) const {
+        return LazyQueueConstIterator{*this, (ptr < pBegin + n) ? pEnd - (pBegin + n - ptr) : ptr - n, offset - n};
+    }
+    inline void operator-=(const size_t& n) {
+        ptr = (ptr < pBegin + n) ? pEnd - (pBegin + n - ptr) : ptr - n;
+        offset -= n;
+    }
+
+    inline bool operator==(const LazyQueueConstIterator& other) const {
+        return ptr == other.ptr;
+    }
+
+    const size_t size;
+
+private:
+    const Type* ptr;
+    const Type* pBegin;
+    const Type* pEnd;
+    const Type* value;  // value of virtual elements
+    const size_t lazy;  // number of virtual elements
+    size_t offset;      // offset from the most old element
+};
+
+}; // namespace ns
@@ -0,0 +1,22 @@
+/**
+ * @file LazyShaperMetrics.hpp
+ * 
+ * @brief This file contains the definition of the LazyShaperMetrics alias.
+ * 
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "ShaperMetrics.hpp"
+#include "LazyQueue.hpp"
+
+namespace ns {
+/**
+ * ShaperMetrics with lazy queues of moving metrics, same results with ShaperMetrics.
+ * initialize does not write the rings of moving metrics, so it does not depend on extents.
+ */
+template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+using LazyShaperMetrics = BasicShaperMetrics<Type, DerivativeMetrics, Queue<Type, Extent>, BasicMovingMetricsNested<LazyQueue, Type, MeanMetrics, Extents...>>;
+}; // namespace ns
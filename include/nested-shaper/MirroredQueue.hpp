@@ -0,0 +1,314 @@
+/**
+ * @file MirroredQueue.hpp
+ *
+ * @brief This file contains the definition of the MirroredQueue class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for ns::span
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+template<typename Type>
+struct MirroredQueueIterator;
+template<typename Type>
+struct MirroredQueueConstIterator;
+
+/**
+ * @class MirroredQueue
+ *
+ * A template based queue class, interchangeable with Queue.
+ * Every sample is written twice, into _data[i] and _data[i + capacity].
+ * Therefore the live window is always a single contiguous range [_data + _back, _data + _back + _size).
+ *
+ * @tparam Type Type of the elements.
+ * @tparam Extent Maximum extent of the queue.
+ */
+template<typename Type, size_t Extent>
+class MirroredQueue {
+public:
+    using value_type = Type;
+    using reference = Type&;
+    using const_reference = const Type&;
+    using size_type = size_t;
+    static constexpr size_type extent = Extent;
+
+    template<typename _Type>
+    friend struct MirroredQueueIterator;
+    template<typename _Type>
+    friend struct MirroredQueueConstIterator;
+
+    /**
+     * Constructors
+     */
+    MirroredQueue();
+    explicit MirroredQueue(const size_type& capacity);
+
+    /**
+     * Status of the queue
+     */
+    inline bool isEmpty() const { return _size == 0; }
+    inline bool isFull() const { return _size == _capacity; }
+    inline size_type capacity() const { return _capacity; }
+    inline size_type size() const { return _size; }
+
+    /**
+     * Accessors
+     *
+     * front : retrieve from the most recent index
+     * back : retrieve from the most old index
+     * span : contiguous range of the queue, from the most old to the most recent.
+     */
+    inline reference front(const size_type& index = 0) {
+        assert(index < _size);
+        return _data[_back + _size - 1U - index];
+    }
+    inline const_reference front(const size_type& index = 0) const {
+        assert(index < _size);
+        return _data[_back + _size - 1U - index];
+    }
+    inline reference back(const size_type& index = 0) {
+        assert(index < _size);
+        return _data[_back + index];
+    }
+    inline const_reference back(const size_type& index = 0) const {
+        assert(index < _size);
+        return _data[_back + index];
+    }
+    inline ns::span<const Type> span() const { return ns::span<const Type>{_data + _back, _size}; }
+
+    /**
+     * reset : Set queue as empty
+     * resize : Set capacity of queue
+     */
+    void reset();
+    void resize(const size_type& size);
+
+    /**
+     * Pop and Push
+     */
+    void pop();
+    void push(const value_type& value);
+
+    /**
+     * Push to a full queue, and returns the popped value.
+     * Does not check about queue size.
+     */
+    value_type shift(const value_type& value);
+
+    /**
+     * Fill the queue with given value.
+     */
+    void fill(const value_type& value);
+
+    /**
+     * Iterators
+     *
+     * Warnings :
+     * forwardIterator should use ++ or + operator.
+     * backwardIterator should use -- or - operator.
+     */
+    inline MirroredQueueIterator<Type> forwardIterator() { return MirroredQueueIterator<Type>(*this, _data + _back); }
+    inline MirroredQueueIterator<Type> backwardIterator() { return MirroredQueueIterator<Type>(*this, _data + _back + _size - 1U); }
+    inline MirroredQueueConstIterator<Type> forwardConstIterator() const { return MirroredQueueConstIterator<Type>{*this, _data + _back}; }
+    inline MirroredQueueConstIterator<Type> backwardConstIterator() const { return MirroredQueueConstIterator<Type>{*this, _data + _back + _size - 1U}; }
+
+protected:
+    value_type _data[2U * Extent]{};
+    size_type _capacity; // maximum size
+    size_type _size{0};  // current size
+    size_type _back{0};  // old index, always less than _capacity
+
+    inline void write(const size_type& index, const value_type& value) {
+        _data[index] = value;
+        _data[index + _capacity] = value;
+    }
+};
+
+template<typename Type, size_t Extent>
+constexpr typename MirroredQueue<Type, Extent>::size_type MirroredQueue<Type, Extent>::extent;
+
+template<typename Type, size_t Extent>
+MirroredQueue<Type, Extent>::MirroredQueue() :
+_capacity(Extent) {}
+
+template<typename Type, size_t Extent>
+MirroredQueue<Type, Extent>::MirroredQueue(const size_type& capacity) :
+_capacity(capacity) {
+    assert(capacity <= Extent);
+}
+
+template<typename Type, size_t Extent>
+void MirroredQueue<Type, Extent>::reset() {
+    _size = 0;
+    _back = 0;
+}
+
+template<typename Type, size_t Extent>
+void MirroredQueue<Type, Extent>::resize(const size_type& size) {
+    if(size > Extent) {
+        assert(false);
+        resize(Extent);
+        return;
+    }
+
+    if(size == _capacity) {
+        return;
+    }
+
+    _capacity = size;
+    reset();
+}
+
+template<typename Type, size_t Extent>
+void MirroredQueue<Type, Extent>::pop() {
+    if(isEmpty()) {
+        assert(false);
+        return;
+    }
+
+    --_size;
+    _back == _capacity - 1U ? _back = 0 : _back++;
+}
+
+template<typename Type, size_t Extent>
+void MirroredQueue<Type, Extent>::push(const value_type& value) {
+    if(isFull()) {
+        pop();
+    }
+
+    const size_type index = _back + _size;
+    write(index >= _capacity ? index - _capacity : index, value);
+    ++_size;
+}
+
+template<typename Type, size_t Extent>
+typename MirroredQueue<Type, Extent>::value_type MirroredQueue<Type, Extent>::shift(const value_type& value) {
+    const value_type result = _data[_back];
+    write(_back, value);
+    _back == _capacity - 1U ? _back = 0 : _back++;
+    return result;
+}
+
+template<typename Type, size_t Extent>
+void MirroredQueue<Type, Extent>::fill(const value_type& value) {
+    _size = _capacity;
+    _back = 0;
+
+    for(size_type i = 0; i < 2U * _capacity; ++i) {
+        _data[i] = value;
+    }
+}
+
+/**
+ * Iterator of mirrored buffer.
+ * The window is contiguous, so the iterator never wraps and provides span of the window.
+ */
+template<typename Type>
+struct MirroredQueueIterator {
+    template<size_t Extent>
+    explicit MirroredQueueIterator(MirroredQueue<Type, Extent>& queue, Type* _ptr) :
+    size(queue._size), ptr(_ptr), pBegin(queue._data + queue._back) {}
+    MirroredQueueIterator(const MirroredQueueIterator&) = default;
+    MirroredQueueIterator(const MirroredQueueIterator<Type>& other, Type* _ptr) :
+    size(other.size), ptr(_ptr), pBegin(other.pBegin) {}
+
+    inline Type& operator*() const { return *ptr; }
+
+    inline MirroredQueueIterator& operator++() {
+        ++ptr;
+        return *this;
+    }
+    inline MirroredQueueIterator operator++(int) {
+        MirroredQueueIterator tmp(*this);
+        operator++();
+        return tmp;
+    }
+    inline MirroredQueueIterator& operator--() {
+        --ptr;
+        return *this;
+    }
+    inline MirroredQueueIterator operator--(int) {
+        MirroredQueueIterator tmp(*this);
+        operator--();
+        return tmp;
+    }
+
+    inline MirroredQueueIterator operator+(const size_t& n) const { return MirroredQueueIterator{*this, ptr + n}; }
+    inline void operator+=(const size_t& n) { ptr += n; }
+    inline MirroredQueueIterator operator-(const size_t& n) const { return MirroredQueueIterator{*this, ptr - n}; }
+    inline void operator-=(const size_t& n) { ptr -= n; }
+
+    inline bool operator==(const MirroredQueueIterator& other) const {
+        return ptr == other.ptr;
+    }
+
+    /**
+     * Contiguous range of the whole queue, from the most old to the most recent.
+     */
+    inline ns::span<Type> span() const { return ns::span<Type>{pBegin, size}; }
+
+    const size_t size;
+
+private:
+    Type* ptr;
+    Type* pBegin;
+};
+
+template<typename Type>
+struct MirroredQueueConstIterator {
+    template<size_t Extent>
+    explicit MirroredQueueConstIterator(const MirroredQueue<Type, Extent>& queue, const Type* _ptr) :
+    size(queue._size), ptr(_ptr), pBegin(queue._data + queue._back) {}
+    MirroredQueueConstIterator(const MirroredQueueConstIterator&) = default;
+    MirroredQueueConstIterator(const MirroredQueueConstIterator<Type>& other, const Type* _ptr) :
+    size(other.size), ptr(_ptr), pBegin(other.pBegin) {}
+
+    inline const Type& operator*() const { return *ptr; }
+
+    inline MirroredQueueConstIterator& operator++() {
+        ++ptr;
+        return *this;
+    }
+    inline MirroredQueueConstIterator operator++(int) {
+        MirroredQueueConstIterator tmp(*this);
+        operator++();
+        return tmp;
+    }
+    inline MirroredQueueConstIterator& operator--() {
+        --ptr;
+        return *this;
+    }
+    inline MirroredQueueConstIterator operator--(int) {
+        MirroredQueueConstIterator tmp(*this);
+        operator--();
+        return tmp;
+    }
+
+    inline MirroredQueueConstIterator operator+(const size_t& n) const { return MirroredQueueConstIterator{*this, ptr + n}; }
+    inline void operator+=(const size_t& n) { ptr += n; }
+    inline MirroredQueueConstIterator operator-(const size_t& n) const { return MirroredQueueConstIterator{*this, ptr - n}; }
+    inline void operator-=(const size_t& n) { ptr -= n; }
+
+    inline bool operator==(const MirroredQueueConstIterator& other) const {
+        return ptr == other.ptr;
+    }
+
+    /**
+     * Contiguous range of the whole queue, from the most old to the most recent.
+     */
+    inline ns::span<const Type> span() const { return ns::span<const Type>{pBegin, size}; }
+
+    const size_t size;
+
+private:
+    const Type* ptr;
+    const Type* const pBegin;
+};
+
+}; // namespace ns
@@ -10,7 +10,68 @@
 
 #include "Queue.hpp"
 
+#ifndef NESTED_SHAPER_BLOCK_SIZE
+#define NESTED_SHAPER_BLOCK_SIZE 64
+#endif
+
 namespace ns {
+/**
+ * Metrics functor may provide initialize(value, capacity), which is called whenever the queue is filled with value.
+ * e.g. running sums of the window, or values depending on the capacity.
+ */
+template<typename Metrics, typename Type>
+inline auto initialize_metrics(Metrics& metrics, const Type& value, const size_t& capacity, int) -> decltype(metrics.initialize(value, capacity), void()) {
+    metrics.initialize(value, capacity);
+}
+
+template<typename Metrics, typename Type>
+inline void initialize_metrics(Metrics& metrics, const Type& value, const size_t& capacity, long) {
+    (void)metrics;
+    (void)value;
+    (void)capacity;
+}
+
+/**
+ * Whether the metrics functor provides a block kernel, and the queue provides segments and pushN,
+ * so that convoluteBlock of MovingMetrics runs the block kernel over chunks, instead of convolute for every sample.
+ */
+template<typename Metrics, typename Queue, typename Type>
+constexpr auto has_block_kernel(int) -> decltype(static_cast<Metrics*>(nullptr)->block(Type(), static_cast<const Type*>(nullptr), static_cast<Type*>(nullptr), size_t(0), size_t(0)),
+                                                 static_cast<Queue*>(nullptr)->segments(),
+                                                 static_cast<Queue*>(nullptr)->pushN(static_cast<const Type*>(nullptr), size_t(0)),
+                                                 bool()) {
+    return true;
+}
+
+template<typename Metrics, typename Queue, typename Type>
+constexpr bool has_block_kernel(long) {
+    return false;
+}
+
+/**
+ * Convolute kernel of size elements with a box of capacity elements (a moving average), in place.
+ * kernel should have room for size + capacity - 1 elements, returns the new size.
+ */
+template<typename Type>
+size_t convolute_box(Type* kernel, const size_t& size, const size_t& capacity) {
+    const size_t result = size + capacity - 1U;
+
+    // Prefix sums of the kernel, zero padded.
+    for(size_t i = 1; i < size; ++i) {
+        kernel[i] += kernel[i - 1U];
+    }
+    for(size_t i = size; i < result; ++i) {
+        kernel[i] = kernel[size - 1U];
+    }
+
+    // Sums of capacity elements, from the end, as kernel[i - capacity] is not overwritten yet.
+    for(size_t i = result; i-- > 0;) {
+        kernel[i] = (i >= capacity ? kernel[i] - kernel[i - capacity] : kernel[i]) / Type(capacity);
+    }
+
+    return result;
+}
+
 /**
  * @class MovingMetrics
  * 
@@ -24,9 +85,21 @@ namespace ns {
  *   struct EmptyMetrics {
  *   Type operator()(const Type& mean, const Type& popped, const Type& pushed, QueueConstIterator<Type> forwardIterator, QueueConstIterator<Type> backwardIterator) const { return mean; }
  * };
+ * 
+ * Metrics functor may also provide the following, called by initialize:
+ * void initialize(const Type& value, const size_t& capacity);
+ * 
+ * and a block kernel, called by convoluteBlock for chunks of up to NESTED_SHAPER_BLOCK_SIZE samples:
+ * Type block(const Type& mean, const Type* history, Type* output, const size_t& n, const size_t& capacity);
+ * history[0, capacity) is the window before the chunk, and history[capacity + i] is the i-th input,
+ * so the i-th popped sample is history[i], and the window after the i-th sample is history[i + 1, i + capacity].
+ * output[i] is the mean after the i-th sample, and the mean after the chunk is returned.
+ * 
+ * QueueType is a queue class template, which stores the samples. (Queue, PowerOfTwoQueue, LazyQueue)
+ * Iterators passed to the metrics functor are the const iterators of QueueType.
  */
-template<typename Type, size_t Extent, typename Metrics>
-class MovingMetrics : protected Queue<Type, Extent> {
+template<typename Type, size_t Extent, typename Metrics, template<typename, size_t> class QueueType = Queue>
+class MovingMetrics : protected QueueType<Type, Extent> {
 public:
     using value_type = Type;
     using reference = Type&;
@@ -37,14 +110,14 @@ class MovingMetrics : protected Queue<Type, Extent> {
      * Constructors
      */
     explicit MovingMetrics(const Type& value) :
-    Queue<Type, Extent>() { initialize(value); };
+    QueueType<Type, Extent>() { initialize(value); };
     explicit MovingMetrics(const Type& value, const size_type& capacity_) :
-    Queue<Type, Extent>(capacity_) { initialize(value, capacity_); };
+    QueueType<Type, Extent>(capacity_) { initialize(value, capacity_); };
 
     /**
      * Status of the queue
      */
-    using Queue<Type, Extent>::capacity;
+    using QueueType<Type, Extent>::capacity;
 
     /**
      * (Re)Initializers
@@ -62,64 +135,108 @@ class MovingMetrics : protected Queue<Type, Extent> {
      */
     Type convolute(const Type& value);
 
+    /**
+     * Convolute a block of n samples, same as n calls of convolute.
+     * output may be the same as input.
+     * If the metrics functor provides block and the queue provides segments and pushN (Queue),
+     * each chunk is copied once into a contiguous history, the block kernel runs over it without shifting the queue,
+     * and the queue is updated by a single pushN. Otherwise, convolute is called for every sample.
+     */
+    void convoluteBlock(const Type* input, Type* output, const size_type& n);
+
+    /**
+     * Snapshot and Restore
+     * 
+     * The whole state is copied by a single memcpy.
+     * Type, Metrics and QueueType should be trivially copyable.
+     */
+    using state_type = state_block<MovingMetrics>;
+    inline state_type snapshot() const {
+        state_type state;
+        save_state(*this, state);
+        return state;
+    }
+    inline void restore(const state_type& state) { load_state(*this, state); }
+
 protected:
     Type mean{};       // Mean(average) value
     Metrics metrics{}; // Metrics functor
 
-    using Queue<Type, Extent>::fill;
-    using Queue<Type, Extent>::_data;
-    using Queue<Type, Extent>::_capacity;
-    using Queue<Type, Extent>::_size;
-    using Queue<Type, Extent>::_back;
-    using Queue<Type, Extent>::_front;
+    using QueueType<Type, Extent>::fill;
 
-    /**
-     * Push the value to the queue and returns popped data.
-     * Does not check about queue size.
-     */
-    Type push(const Type& value);
+    // Block kernel of the metrics functor, over the window and the chunk in a contiguous history
+    template<typename _Metrics, typename _Queue>
+    auto convoluteBlock(_Metrics& metrics_, _Queue& queue, const Type* input, Type* output, size_type n, int) -> decltype(metrics_.block(mean, input, output, n, n), queue.segments(), queue.pushN(input, n), void()) {
+        Type history[Extent + NESTED_SHAPER_BLOCK_SIZE];
+        const size_type size = capacity();
+
+        while(n > 0) {
+            const size_type chunk = n < NESTED_SHAPER_BLOCK_SIZE ? n : NESTED_SHAPER_BLOCK_SIZE;
+
+            const auto window = queue.segments(); // the queue is always full
+            copy_n(window.first.data, window.first.size, history);
+            copy_n(window.second.data, window.second.size, history + window.first.size);
+            copy_n(input, chunk, history + size);
+
+            mean = metrics_.block(mean, history, output, chunk, size);
+            queue.pushN(history + size, chunk); // input may be overwritten by output
+
+            input += chunk;
+            output += chunk;
+            n -= chunk;
+        }
+    }
+
+    template<typename _Metrics, typename _Queue>
+    void convoluteBlock(_Metrics& metrics_, _Queue& queue, const Type* input, Type* output, const size_type& n, long) {
+        (void)metrics_;
+        (void)queue;
+        for(size_type i = 0; i < n; ++i) {
+            output[i] = convolute(input[i]);
+        }
+    }
 };
 
-template<typename Type, size_t Extent, typename Metrics>
-void MovingMetrics<Type, Extent, Metrics>::initialize(const Type& value) {
+template<typename Type, size_t Extent, typename Metrics, template<typename, size_t> class QueueType>
+void MovingMetrics<Type, Extent, Metrics, QueueType>::initialize(const Type& value) {
     mean = value;
     metrics = Metrics{};
+    initialize_metrics(metrics, value, capacity(), 0);
     fill(value);
 };
 
-template<typename Type, size_t Extent, typename Metrics>
-void MovingMetrics<Type, Extent, Metrics>::initialize(const Type& value, const size_type& capacity_) {
-    Queue<Type, Extent>::resize(capacity_);
+template<typename Type, size_t Extent, typename Metrics, template<typename, size_t> class QueueType>
+void MovingMetrics<Type, Extent, Metrics, QueueType>::initialize(const Type& value, const size_type& capacity_) {
+    QueueType<Type, Extent>::resize(capacity_);
     initialize(value);
 };
 
-template<typename Type, size_t Extent, typename Metrics>
-Type MovingMetrics<Type, Extent, Metrics>::convolute(const Type& value) {
+template<typename Type, size_t Extent, typename Metrics, template<typename, size_t> class QueueType>
+Type MovingMetrics<Type, Extent, Metrics, QueueType>::convolute(const Type& value) {
+    const Type popped = QueueType<Type, Extent>::shift(value); // iterators must be created after shift
     mean = metrics.template
            operator()(mean,
-                      push(value),
+                      popped,
                       value,
-                      Queue<Type, Extent>::forwardConstIterator(),
-                      Queue<Type, Extent>::backwardConstIterator());
+                      QueueType<Type, Extent>::forwardConstIterator(),
+                      QueueType<Type, Extent>::backwardConstIterator());
     return mean;
 };
 
-template<typename Type, size_t Extent, typename Metrics>
-Type MovingMetrics<Type, Extent, Metrics>::push(const Type& value) {
-    const Type result = *_back;
-    _back == _data + _capacity - 1 ? _back = _data : _back++;
-    _front == _data + _capacity - 1 ? _front = _data : _front++;
-    *_front = value;
-    return result;
+template<typename Type, size_t Extent, typename Metrics, template<typename, size_t> class QueueType>
+void MovingMetrics<Type, Extent, Metrics, QueueType>::convoluteBlock(const Type* input, Type* output, const size_type& n) {
+    convoluteBlock(metrics, static_cast<QueueType<Type, Extent>&>(*this), input, output, n, 0);
 };
 
 // Helper class for MovingMetrics
-template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
-struct MovingMetricsNested {
-    explicit MovingMetricsNested(const Type& value) :
+// With block kernels, convoluteBlock runs stage by stage over the block, the output of each stage is the input of the next stage.
+// Otherwise it runs sample by sample, as recursive updates of every stage overlap, which stage by stage would serialize.
+template<template<typename, size_t> class QueueType, typename Type, typename Metrics, size_t Extent, size_t... Extents>
+struct BasicMovingMetricsNested {
+    explicit BasicMovingMetricsNested(const Type& value) :
     moving_metrics(value), moving_metrics_nested(value) {}
     template<typename Arg, typename... Args>
-    explicit MovingMetricsNested(const Type& value, const Arg& capacity, const Args&... capacities) :
+    explicit BasicMovingMetricsNested(const Type& value, const Arg& capacity, const Args&... capacities) :
     moving_metrics(value, capacity), moving_metrics_nested(value, capacities...) {
         static_assert(sizeof...(capacities) == sizeof...(Extents), "Number of capacities must be equal to number of extents.");
     }
@@ -140,16 +257,38 @@ struct MovingMetricsNested {
         return moving_metrics_nested.convolute(moving_metrics.convolute(value));
     }
 
-    MovingMetrics<Type, Extent, Metrics> moving_metrics;
-    MovingMetricsNested<Type, Metrics, Extents...> moving_metrics_nested;
+    inline void convoluteBlock(const Type* input, Type* output, const size_t& n) {
+        if(!has_block_kernel<Metrics, QueueType<Type, Extent>, Type>(0)) {
+            for(size_t i = 0; i < n; ++i) {
+                output[i] = convolute(input[i]);
+            }
+            return;
+        }
+
+        moving_metrics.convoluteBlock(input, output, n);
+        moving_metrics_nested.convoluteBlock(output, output, n);
+    }
+
+    // Size of the composite kernel, which is the convolution of boxes of every stage.
+    inline size_t kernelSize() const {
+        return moving_metrics.capacity() - 1U + moving_metrics_nested.kernelSize();
+    }
+
+    // Convolute kernel of size elements with boxes of every stage, returns the new size.
+    inline size_t convoluteKernel(Type* kernel, const size_t& size) const {
+        return moving_metrics_nested.convoluteKernel(kernel, convolute_box(kernel, size, moving_metrics.capacity()));
+    }
+
+    MovingMetrics<Type, Extent, Metrics, QueueType> moving_metrics;
+    BasicMovingMetricsNested<QueueType, Type, Metrics, Extents...> moving_metrics_nested;
 };
 
-template<typename Type, typename Metrics, size_t Extent>
-struct MovingMetricsNested<Type, Metrics, Extent> {
-    explicit MovingMetricsNested(const Type& value) :
+template<template<typename, size_t> class QueueType, typename Type, typename Metrics, size_t Extent>
+struct BasicMovingMetricsNested<QueueType, Type, Metrics, Extent> {
+    explicit BasicMovingMetricsNested(const Type& value) :
     moving_metrics(value) {}
     template<typename Arg>
-    explicit MovingMetricsNested(const Type& value, const Arg& capacity) :
+    explicit BasicMovingMetricsNested(const Type& value, const Arg& capacity) :
     moving_metrics(value, capacity) {}
 
     inline void initialize(const Type& value) {
@@ -164,6 +303,21 @@ struct MovingMetricsNested<Type, Metrics, Extent> {
         return moving_metrics.convolute(value);
     };
 
-    MovingMetrics<Type, Extent, Metrics> moving_metrics;
+    inline void convoluteBlock(const Type* input, Type* output, const size_t& n) {
+        moving_metrics.convoluteBlock(input, output, n);
+    };
+
+    inline size_t kernelSize() const {
+        return moving_metrics.capacity();
+    };
+
+    inline size_t convoluteKernel(Type* kernel, const size_t& size) const {
+        return convolute_box(kernel, size, moving_metrics.capacity());
+    };
+
+    MovingMetrics<Type, Extent, Metrics, QueueType> moving_metrics;
 };
+
+template<typename Type, typename Metrics, size_t Extent, size_t... Extents>
+using MovingMetricsNested = BasicMovingMetricsNested<Queue, Type, Metrics, Extent, Extents...>;
 }; // namespace ns
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include "version.hpp"
 #include "metrics/euclidean_derivative_metrics.hpp"
 #include "metrics/euclidean_mean_cumulative_metrics.hpp"
@@ -15,7 +16,23 @@
 #include "metrics/angle_derivative_metrics.hpp"
 #include "metrics/angle_mean_cumulative_metrics.hpp"
 #include "metrics/angle_mean_recursive_metrics.hpp"
+#include "metrics/euclidean_derivative_fixed_point_metrics.hpp"
+#include "metrics/euclidean_mean_integer_metrics.hpp"
+#include "metrics/euclidean_mean_running_sum_metrics.hpp"
+#include "metrics/angle_mean_running_sum_metrics.hpp"
+#include "metrics/euclidean_mean_resync_metrics.hpp"
+#include "metrics/euclidean_derivative_selected_metrics.hpp"
+#include "metrics/euclidean_derivative_backward_metrics.hpp"
+#include "metrics/euclidean_derivative_fixed_dt_metrics.hpp"
+#include "metrics/angle_derivative_fixed_dt_metrics.hpp"
 #include "ShaperMetrics.hpp"
+#include "ArenaShaperMetrics.hpp"
+#include "FusedShaperMetrics.hpp"
+#include "LazyShaperMetrics.hpp"
+#include "CICShaperMetrics.hpp"
+#include "StageShaperMetrics.hpp"
+#include "FixedDtShaperMetrics.hpp"
+#include "QueueSoA.hpp"
 
 namespace ns {
 template<typename Type, size_t DerivativeOrder, size_t... Extents>
@@ -45,4 +62,108 @@ template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Exte
 using NestedShaperAngleRecursiveArray = ShaperMetrics<array<Type, Dimension>, AngleDerivativeMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, AngleMeanRecursiveMetricsArray<Type, Dimension>, Extents...>;
 template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
 using NestedShaperAngleArray = NestedShaperAngleRecursiveArray<array<Type, Dimension>, Dimension, DerivativeOrder, Extents...>;
+
+// Structure-of-arrays storage, each dimension is stored in its own contiguous lane.
+// Only cumulative metrics, as recursive metrics never read the window, and would only pay for gathering lanes.
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanCumulativeArraySoA = QueuedShaperMetrics<QueueSoA, array<Type, Dimension>, EuclideanDerivativeMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, EuclideanMeanCumulativeMetricsArray<Type, Dimension>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleCumulativeArraySoA = QueuedShaperMetrics<QueueSoA, array<Type, Dimension>, AngleDerivativeMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, AngleMeanCumulativeMetricsArray<Type, Dimension>, Extents...>;
+
+// Runtime extents of moving metrics, allocated from an arena.
+template<typename Type, size_t DerivativeOrder, size_t Stages>
+using NestedShaperEuclideanCumulativeArena = ArenaShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Stages>;
+template<typename Type, size_t DerivativeOrder, size_t Stages>
+using NestedShaperEuclideanRecursiveArena = ArenaShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Stages>;
+template<typename Type, size_t DerivativeOrder, size_t Stages>
+using NestedShaperAngleCumulativeArena = ArenaShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanCumulativeMetrics<Type>, Stages>;
+template<typename Type, size_t DerivativeOrder, size_t Stages>
+using NestedShaperAngleRecursiveArena = ArenaShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanRecursiveMetrics<Type>, Stages>;
+
+// Fused moving metrics, every stage is updated in a single loop.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanCumulativeFused = FusedShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveFused = FusedShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleCumulativeFused = FusedShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleRecursiveFused = FusedShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanRecursiveMetrics<Type>, Extents...>;
+
+// Lazy queues of moving metrics, initialize does not depend on extents.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanCumulativeLazy = LazyShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveLazy = LazyShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleCumulativeLazy = LazyShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleRecursiveLazy = LazyShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanRecursiveMetrics<Type>, Extents...>;
+
+// Integer (or fixed-point) samples, exact running sums without floating point.
+// SumType accumulates running sums and weighted sums of derivatives, FractionBits is the precision of derivative coefficients.
+template<typename Type, typename SumType, size_t FractionBits, size_t DerivativeOrder, size_t... Extents>
+using BasicNestedShaperInteger = ShaperMetrics<Type, EuclideanDerivativeFixedPointMetrics<Type, DerivativeOrder, FractionBits, SumType>, DerivativeOrder, EuclideanMeanIntegerMetrics<Type, SumType>, Extents...>;
+template<typename Type, typename SumType, size_t FractionBits, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using BasicNestedShaperIntegerArray = ShaperMetrics<array<Type, Dimension>, EuclideanDerivativeFixedPointMetricsArray<Type, Dimension, DerivativeOrder, FractionBits, SumType>, DerivativeOrder, EuclideanMeanIntegerMetricsArray<Type, Dimension, SumType>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperInteger = BasicNestedShaperInteger<Type, int64_t, 16, DerivativeOrder, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperIntegerArray = BasicNestedShaperIntegerArray<Type, int64_t, 16, Dimension, DerivativeOrder, Extents...>;
+
+// Integer samples, nested moving averages as a CIC filter, rounded once.
+template<typename Type, typename SumType, size_t FractionBits, size_t DerivativeOrder, size_t... Extents>
+using BasicNestedShaperCIC = CICShaperMetrics<Type, EuclideanDerivativeFixedPointMetrics<Type, DerivativeOrder, FractionBits, SumType>, DerivativeOrder, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperCIC = BasicNestedShaperCIC<Type, int64_t, 16, DerivativeOrder, Extents...>;
+
+// Compensated running sums, scaled by the reciprocal of the window size.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRunningSum = ShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanRunningSumMetrics<Type>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRunningSumArray = ShaperMetrics<array<Type, Dimension>, EuclideanDerivativeMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, EuclideanMeanRunningSumMetricsArray<Type, Dimension>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleRunningSum = ShaperMetrics<Type, AngleDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanRunningSumMetrics<Type>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleRunningSumArray = ShaperMetrics<array<Type, Dimension>, AngleDerivativeMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, AngleMeanRunningSumMetricsArray<Type, Dimension>, Extents...>;
+
+// Recursive running sums, resynchronized with the exact sum of the window every window size.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanResync = ShaperMetrics<Type, EuclideanDerivativeMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanResyncMetrics<Type>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanResyncArray = ShaperMetrics<array<Type, Dimension>, EuclideanDerivativeMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, EuclideanMeanResyncMetricsArray<Type, Dimension>, Extents...>;
+
+// Only the selected derivative orders are computed and returned, e.g. derivative_orders<0, 2> for position and acceleration.
+template<typename Type, size_t DerivativeOrder, typename Orders, size_t... Extents>
+using NestedShaperEuclideanCumulativeSelected = ShaperMetrics<Type, EuclideanDerivativeSelectedMetrics<Type, DerivativeOrder, Orders>, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, typename Orders, size_t... Extents>
+using NestedShaperEuclideanRecursiveSelected = ShaperMetrics<Type, EuclideanDerivativeSelectedMetrics<Type, DerivativeOrder, Orders>, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Extents...>;
+
+// Derivatives from differences of each stage, without the derivative queue, DerivativeOrder - 1 up to the number of stages.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanCumulativeStage = StageShaperMetrics<Type, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveStage = StageShaperMetrics<Type, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Extents...>;
+
+// One-sided derivatives at the latest sample, without the N / 2 samples of delay of central differences.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanCumulativeBackward = ShaperMetrics<Type, EuclideanDerivativeBackwardMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveBackward = ShaperMetrics<Type, EuclideanDerivativeBackwardMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveBackwardArray = ShaperMetrics<array<Type, Dimension>, EuclideanDerivativeBackwardMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetricsArray<Type, Dimension>, Extents...>;
+
+// Coefficients are divided by dt^k once for a fixed dt, derivatives without division, constructed as {value, dt}.
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanCumulativeFixedDt = FixedDtShaperMetrics<Type, EuclideanDerivativeFixedDtMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveFixedDt = FixedDtShaperMetrics<Type, EuclideanDerivativeFixedDtMetrics<Type, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetrics<Type>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperEuclideanRecursiveFixedDtArray = FixedDtShaperMetrics<array<Type, Dimension>, EuclideanDerivativeFixedDtMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, EuclideanMeanRecursiveMetricsArray<Type, Dimension>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleCumulativeFixedDt = FixedDtShaperMetrics<Type, AngleDerivativeFixedDtMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanCumulativeMetrics<Type>, Extents...>;
+template<typename Type, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleRecursiveFixedDt = FixedDtShaperMetrics<Type, AngleDerivativeFixedDtMetrics<Type, DerivativeOrder>, DerivativeOrder, AngleMeanRecursiveMetrics<Type>, Extents...>;
+template<typename Type, size_t Dimension, size_t DerivativeOrder, size_t... Extents>
+using NestedShaperAngleRecursiveFixedDtArray = FixedDtShaperMetrics<array<Type, Dimension>, AngleDerivativeFixedDtMetricsArray<Type, Dimension, DerivativeOrder>, DerivativeOrder, AngleMeanRecursiveMetricsArray<Type, Dimension>, Extents...>;
 }; // namespace ns
\ No newline at end of file
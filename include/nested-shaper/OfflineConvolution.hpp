@@ -0,0 +1,210 @@
+/**
+ * @file OfflineConvolution.hpp
+ *
+ * @brief This file contains the radix-2 FFT, the overlap-add convolution and offline shaping of whole recordings.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for ns::next_power_of_two
+#include "ShaperMetrics.hpp" // for ns::initialize_derivative_metrics
+#include <stddef.h>
+#include <assert.h>
+#include <math.h>
+
+namespace ns {
+/**
+ * Size of FFT for a kernel of kernel_size elements, power of two and at least twice of kernel_size.
+ * Each block of overlap-add is fft_size - kernel_size + 1 samples.
+ */
+constexpr size_t offline_fft_size(const size_t kernel_size) {
+    return next_power_of_two(2U * kernel_size);
+}
+
+/**
+ * Number of elements of workspace, required by overlap_add.
+ * Spectrum of the kernel and a block (real and imaginary parts), twiddle factors and the tail of the previous block.
+ */
+constexpr size_t overlap_add_workspace_size(const size_t kernel_size) {
+    return 5U * offline_fft_size(kernel_size) + kernel_size;
+}
+
+/**
+ * Twiddle factors of FFT of n elements, cos(2 pi k / n) and sin(2 pi k / n) for k < n / 2.
+ */
+template<typename Type>
+void fft_twiddles(Type* cos_, Type* sin_, const size_t& n) {
+    for(size_t k = 0; k < n / 2U; ++k) {
+        const double angle = 2.0 * M_PI * double(k) / double(n);
+        cos_[k] = Type(::cos(angle));
+        sin_[k] = Type(::sin(angle));
+    }
+}
+
+/**
+ * In place radix-2 FFT of n elements, n should be a power of two.
+ * inverse computes the inverse transform, including the scaling by 1 / n.
+ */
+template<typename Type>
+void fft(Type* re, Type* im, const Type* cos_, const Type* sin_, const size_t& n, const bool& inverse) {
+    assert((n & (n - 1U)) == 0);
+
+    // Bit reversal permutation
+    for(size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1U;
+        for(; j & bit; bit >>= 1U) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if(i < j) {
+            const Type r = re[i];
+            re[i] = re[j];
+            re[j] = r;
+            const Type m = im[i];
+            im[i] = im[j];
+            im[j] = m;
+        }
+    }
+
+    const Type sign = inverse ? Type(1) : Type(-1);
+    for(size_t length = 2; length <= n; length <<= 1U) {
+        const size_t half = length / 2U;
+        const size_t step = n / length;
+        for(size_t i = 0; i < n; i += length) {
+            for(size_t k = 0; k < half; ++k) {
+                const Type wr = cos_[k * step];
+                const Type wi = sign * sin_[k * step];
+                const size_t a = i + k;
+                const size_t b = a + half;
+                const Type xr = re[b] * wr - im[b] * wi;
+                const Type xi = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - xr;
+                im[b] = im[a] - xi;
+                re[a] += xr;
+                im[a] += xi;
+            }
+        }
+    }
+
+    if(inverse) {
+        for(size_t i = 0; i < n; ++i) {
+            re[i] /= Type(n);
+            im[i] /= Type(n);
+        }
+    }
+}
+
+/**
+ * Convolute input of n samples with kernel of kernel_size elements, by FFT and overlap-add.
+ * Samples before input are initial, as moving metrics initialized with initial.
+ * sink(i, value) is called with the i-th convoluted sample, in order.
+ * workspace should have overlap_add_workspace_size(kernel_size) elements, nothing is done otherwise.
+ */
+template<typename Type, typename Sink>
+void overlap_add(const Type* kernel, const size_t& kernel_size, const Type* input, const size_t& n, const Type& initial, Type* workspace, const size_t& workspace_size, Sink&& sink) {
+    if(kernel_size == 0 || workspace_size < overlap_add_workspace_size(kernel_size)) {
+        assert(false);
+        return;
+    }
+
+    const size_t size = offline_fft_size(kernel_size);
+    const size_t block = size - kernel_size + 1U;
+    const size_t overlap = kernel_size - 1U;
+    Type* const kernel_re = workspace;
+    Type* const kernel_im = kernel_re + size;
+    Type* const re = kernel_im + size;
+    Type* const im = re + size;
+    Type* const cos_ = im + size;
+    Type* const sin_ = cos_ + size / 2U;
+    Type* const tail = sin_ + size / 2U;
+
+    fft_twiddles(cos_, sin_, size);
+
+    for(size_t i = 0; i < size; ++i) {
+        kernel_re[i] = i < kernel_size ? kernel[i] : Type(0);
+        kernel_im[i] = Type(0);
+    }
+    fft(kernel_re, kernel_im, cos_, sin_, size, false);
+
+    for(size_t i = 0; i < overlap; ++i) {
+        tail[i] = Type(0);
+    }
+
+    // Kernel sums to 1, so the initial value is subtracted and the history is zero.
+    for(size_t begin = 0; begin < n; begin += block) {
+        const size_t count = n - begin < block ? n - begin : block;
+        for(size_t i = 0; i < size; ++i) {
+            re[i] = i < count ? input[begin + i] - initial : Type(0);
+            im[i] = Type(0);
+        }
+
+        fft(re, im, cos_, sin_, size, false);
+        for(size_t i = 0; i < size; ++i) {
+            const Type r = re[i] * kernel_re[i] - im[i] * kernel_im[i];
+            im[i] = re[i] * kernel_im[i] + im[i] * kernel_re[i];
+            re[i] = r;
+        }
+        fft(re, im, cos_, sin_, size, true);
+
+        for(size_t i = 0; i < overlap; ++i) {
+            re[i] += tail[i];
+        }
+        for(size_t i = 0; i < count; ++i) {
+            sink(begin + i, re[i] + initial);
+        }
+        for(size_t i = 0; i < overlap; ++i) {
+            tail[i] = re[block + i];
+        }
+    }
+}
+
+/**
+ * Number of elements of workspace, required by shape_offline, the composite kernel followed by workspace of overlap_add.
+ */
+template<typename Shaper>
+inline size_t offline_workspace_size(const Shaper& shaper) {
+    return shaper.kernelSize() + overlap_add_workspace_size(shaper.kernelSize());
+}
+
+/**
+ * Offline shaping
+ *
+ * Convolute a whole recording with the composite kernel of shaper (BasicShaperMetrics) by FFT and overlap-add.
+ * output[i] is the same as shaper.convolute(input[i], dt) after shaper.initialize(input[0]), up to rounding errors.
+ * The state of the shaper is not used nor changed.
+ * workspace should have offline_workspace_size(shaper) elements, nothing is done otherwise.
+ */
+template<typename Shaper, typename TimeType, typename ResultType>
+void shape_offline(const Shaper& shaper, const typename Shaper::value_type* input, ResultType* output, const size_t& n, const TimeType& dt, typename Shaper::value_type* workspace, const size_t& workspace_size) {
+    using Type = typename Shaper::value_type;
+    using DerivativeQueue = typename Shaper::derivative_queue_type;
+    using DerivativeMetrics = typename Shaper::derivative_metrics_type;
+
+    if(n == 0) {
+        return;
+    }
+
+    if(workspace_size < offline_workspace_size(shaper)) {
+        assert(false);
+        return;
+    }
+
+    const size_t kernel_size = shaper.kernelSize();
+    shaper.kernel(workspace);
+
+    // Derivatives are computed as convolute, from positions of the composite kernel.
+    DerivativeQueue queue;
+    queue.fill(input[0]);
+    DerivativeMetrics metrics{};
+    initialize_derivative_metrics(metrics, dt, 0);
+
+    overlap_add(workspace, kernel_size, input, n, input[0], workspace + kernel_size, workspace_size - kernel_size, [&](const size_t& i, const Type& position) {
+        queue.push(position);
+        output[i] = metrics.template operator()(queue.forwardConstIterator(), queue.backwardConstIterator(), dt);
+    });
+}
+}; // namespace ns
@@ -0,0 +1,301 @@
+/**
+ * @file PowerOfTwoQueue.hpp
+ *
+ * @brief This file contains the definition of the PowerOfTwoQueue class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for ns::next_power_of_two
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+template<typename Type>
+struct PowerOfTwoQueueIterator;
+template<typename Type>
+struct PowerOfTwoQueueConstIterator;
+
+/**
+ * @class PowerOfTwoQueue
+ *
+ * A template based queue class, interchangeable with Queue.
+ * Storage is rounded up to a power of two, indices are increased monotonically and wrapped with a mask.
+ * Therefore accessors and iterators are branchless.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam Extent Maximum extent of the queue.
+ */
+template<typename Type, size_t Extent>
+class PowerOfTwoQueue {
+public:
+    using value_type = Type;
+    using reference = Type&;
+    using const_reference = const Type&;
+    using size_type = size_t;
+    static constexpr size_type extent = Extent;
+    static constexpr size_type storage = next_power_of_two(Extent);
+    static constexpr size_type mask = storage - 1U;
+
+    template<typename _Type>
+    friend struct PowerOfTwoQueueIterator;
+    template<typename _Type>
+    friend struct PowerOfTwoQueueConstIterator;
+
+    /**
+     * Constructors
+     */
+    PowerOfTwoQueue();
+    explicit PowerOfTwoQueue(const size_type& capacity);
+
+    /**
+     * Status of the queue
+     */
+    inline bool isEmpty() const { return _head == _tail; }
+    inline bool isFull() const { return _head - _tail == _capacity; }
+    inline size_type capacity() const { return _capacity; }
+    inline size_type size() const { return _head - _tail; }
+
+    /**
+     * Accessors
+     *
+     * front : retrieve from the most recent index
+     * back : retrieve from the most old index
+     */
+    inline reference front(const size_type& index = 0) {
+        assert(index < size());
+        return _data[(_head - 1U - index) & mask];
+    }
+    inline const_reference front(const size_type& index = 0) const {
+        assert(index < size());
+        return _data[(_head - 1U - index) & mask];
+    }
+    inline reference back(const size_type& index = 0) {
+        assert(index < size());
+        return _data[(_tail + index) & mask];
+    }
+    inline const_reference back(const size_type& index = 0) const {
+        assert(index < size());
+        return _data[(_tail + index) & mask];
+    }
+
+    /**
+     * reset : Set queue as empty
+     * resize : Set capacity of queue
+     */
+    void reset();
+    void resize(const size_type& size);
+
+    /**
+     * Pop and Push
+     */
+    void pop();
+    void push(const value_type& value);
+
+    /**
+     * Push to a full queue, and returns the popped value.
+     * Does not check about queue size.
+     */
+    value_type shift(const value_type& value);
+
+    /**
+     * Fill the queue with given value.
+     */
+    void fill(const value_type& value);
+
+    /**
+     * Iterators
+     *
+     * Warnings :
+     * forwardIterator should use ++ or + operator.
+     * backwardIterator should use -- or - operator.
+     */
+    inline PowerOfTwoQueueIterator<Type> forwardIterator() { return PowerOfTwoQueueIterator<Type>(*this, _tail); }
+    inline PowerOfTwoQueueIterator<Type> backwardIterator() { return PowerOfTwoQueueIterator<Type>(*this, _head - 1U); }
+    inline PowerOfTwoQueueConstIterator<Type> forwardConstIterator() const { return PowerOfTwoQueueConstIterator<Type>{*this, _tail}; }
+    inline PowerOfTwoQueueConstIterator<Type> backwardConstIterator() const { return PowerOfTwoQueueConstIterator<Type>{*this, _head - 1U}; }
+
+protected:
+    value_type _data[storage]{};
+    size_type _capacity; // maximum size
+    size_type _tail{0};  // old index, increases monotonically
+    size_type _head{0};  // next index to be pushed, increases monotonically
+};
+
+template<typename Type, size_t Extent>
+constexpr typename PowerOfTwoQueue<Type, Extent>::size_type PowerOfTwoQueue<Type, Extent>::extent;
+template<typename Type, size_t Extent>
+constexpr typename PowerOfTwoQueue<Type, Extent>::size_type PowerOfTwoQueue<Type, Extent>::storage;
+template<typename Type, size_t Extent>
+constexpr typename PowerOfTwoQueue<Type, Extent>::size_type PowerOfTwoQueue<Type, Extent>::mask;
+
+template<typename Type, size_t Extent>
+PowerOfTwoQueue<Type, Extent>::PowerOfTwoQueue() :
+_capacity(Extent) {}
+
+template<typename Type, size_t Extent>
+PowerOfTwoQueue<Type, Extent>::PowerOfTwoQueue(const size_type& capacity) :
+_capacity(capacity) {
+    assert(capacity <= Extent);
+}
+
+template<typename Type, size_t Extent>
+void PowerOfTwoQueue<Type, Extent>::reset() {
+    _tail = 0;
+    _head = 0;
+}
+
+template<typename Type, size_t Extent>
+void PowerOfTwoQueue<Type, Extent>::resize(const size_type& size) {
+    if(size > Extent) {
+        assert(false);
+        resize(Extent);
+        return;
+    }
+
+    if(size == _capacity) {
+        return;
+    }
+
+    _capacity = size;
+    reset();
+}
+
+template<typename Type, size_t Extent>
+void PowerOfTwoQueue<Type, Extent>::pop() {
+    if(isEmpty()) {
+        assert(false);
+        return;
+    }
+
+    ++_tail;
+}
+
+template<typename Type, size_t Extent>
+void PowerOfTwoQueue<Type, Extent>::push(const value_type& value) {
+    if(isFull()) {
+        pop();
+    }
+
+    _data[_head++ & mask] = value;
+}
+
+template<typename Type, size_t Extent>
+typename PowerOfTwoQueue<Type, Extent>::value_type PowerOfTwoQueue<Type, Extent>::shift(const value_type& value) {
+    const value_type result = _data[_tail++ & mask];
+    _data[_head++ & mask] = value;
+    return result;
+}
+
+template<typename Type, size_t Extent>
+void PowerOfTwoQueue<Type, Extent>::fill(const value_type& value) {
+    _tail = 0;
+    _head = _capacity;
+
+    for(size_type i = 0; i < _capacity; ++i) {
+        _data[i] = value;
+    }
+}
+
+/**
+ * Iterator of power of two circular buffer.
+ * Index is wrapped by mask at dereference, so offsets does not require any branch.
+ */
+template<typename Type>
+struct PowerOfTwoQueueIterator {
+    template<size_t Extent>
+    explicit PowerOfTwoQueueIterator(PowerOfTwoQueue<Type, Extent>& queue, const size_t& _index) :
+    size(queue.size()), index(_index), mask(queue.mask), pBegin(queue._data) {}
+    PowerOfTwoQueueIterator(const PowerOfTwoQueueIterator&) = default;
+    PowerOfTwoQueueIterator(const PowerOfTwoQueueIterator<Type>& other, const size_t& _index) :
+    size(other.size), index(_index), mask(other.mask), pBegin(other.pBegin) {}
+
+    inline Type& operator*() const { return pBegin[index & mask]; }
+
+    inline PowerOfTwoQueueIterator& operator++() {
+        ++index;
+        return *this;
+    }
+    inline PowerOfTwoQueueIterator operator++(int) {
+        PowerOfTwoQueueIterator tmp(*this);
+        operator++();
+        return tmp;
+    }
+    inline PowerOfTwoQueueIterator& operator--() {
+        --index;
+        return *this;
+    }
+    inline PowerOfTwoQueueIterator operator--(int) {
+        PowerOfTwoQueueIterator tmp(*this);
+        operator--();
+        return tmp;
+    }
+
+    inline PowerOfTwoQueueIterator operator+(const size_t& n) const { return PowerOfTwoQueueIterator{*this, index + n}; }
+    inline void operator+=(const size_t& n) { index += n; }
+    inline PowerOfTwoQueueIterator operator-(const size_t& n) const { return PowerOfTwoQueueIterator{*this, index - n}; }
+    inline void operator-=(const size_t& n) { index -= n; }
+
+    inline bool operator==(const PowerOfTwoQueueIterator& other) const {
+        return ((index ^ other.index) & mask) == 0U;
+    }
+
+    const size_t size;
+
+private:
+    size_t index;
+    size_t mask;
+    Type* pBegin;
+};
+
+template<typename Type>
+struct PowerOfTwoQueueConstIterator {
+    template<size_t Extent>
+    explicit PowerOfTwoQueueConstIterator(const PowerOfTwoQueue<Type, Extent>& queue, const size_t& _index) :
+    size(queue.size()), index(_index), mask(queue.mask), pBegin(queue._data) {}
+    PowerOfTwoQueueConstIterator(const PowerOfTwoQueueConstIterator&) = default;
+    PowerOfTwoQueueConstIterator(const PowerOfTwoQueueConstIterator<Type>& other, const size_t& _index) :
+    size(other.size), index(_index), mask(other.mask), pBegin(other.pBegin) {}
+
+    inline const Type& operator*() const { return pBegin[index & mask]; }
+
+    inline PowerOfTwoQueueConstIterator& operator++() {
+        ++index;
+        return *this;
+    }
+    inline PowerOfTwoQueueConstIterator operator++(int) {
+        PowerOfTwoQueueConstIterator tmp(*this);
+        operator++();
+        return tmp;
+    }
+    inline PowerOfTwoQueueConstIterator& operator--() {
+        --index;
+        return *this;
+    }
+    inline PowerOfTwoQueueConstIterator operator--(int) {
+        PowerOfTwoQueueConstIterator tmp(*this);
+        operator--();
+        return tmp;
+    }
+
+    inline PowerOfTwoQueueConstIterator operator+(const size_t& n) const { return PowerOfTwoQueueConstIterator{*this, index + n}; }
+    inline void operator+=(const size_t& n) { index += n; }
+    inline PowerOfTwoQueueConstIterator operator-(const size_t& n) const { return PowerOfTwoQueueConstIterator{*this, index - n}; }
+    inline void operator-=(const size_t& n) { index -= n; }
+
+    inline bool operator==(const PowerOfTwoQueueConstIterator& other) const {
+        return ((index ^ other.index) & mask) == 0U;
+    }
+
+    const size_t size;
+
+private:
+    size_t index;
+    const size_t mask;
+    const Type* const pBegin;
+};
+
+}; // namespace ns
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "version.hpp"
+#include "tiny_utility.hpp" // for ns::span, ns::pair, ns::copy_n
 #include <stddef.h>
 #include <assert.h>
 
@@ -19,16 +20,41 @@ struct QueueIterator;
 template<typename Type>
 struct QueueConstIterator;
 
+/**
+ * Extent of a Queue, whose storage is provided at runtime (e.g. ArenaQueue).
+ */
+constexpr size_t dynamic_extent = 0;
+
+/**
+ * Storage of Queue, an embedded array of Extent elements.
+ * With dynamic_extent, a pointer to caller-provided storage of _extent elements, which is set by the derived queue.
+ */
+template<typename Type, size_t Extent>
+struct queue_storage {
+    Type _data[Extent]{};
+    static constexpr size_t _extent = Extent;
+};
+
+template<typename Type, size_t Extent>
+constexpr size_t queue_storage<Type, Extent>::_extent;
+
+template<typename Type>
+struct queue_storage<Type, dynamic_extent> {
+    Type* _data{nullptr};
+    size_t _extent{0};
+};
+
 /**
  * @class Queue
  * 
  * A template based queue class.
+ * Positions are stored as indices, so the queue is trivially copyable if Type is.
  * 
  * @tparam Type Type of the elements.
- * @tparam Extent Maximum extent of the queue.
+ * @tparam Extent Maximum extent of the queue, or dynamic_extent for caller-provided storage.
  */
 template<typename Type, size_t Extent>
-class Queue {
+class Queue : protected queue_storage<Type, Extent> {
 public:
     using value_type = Type;
     using reference = Type&;
@@ -66,6 +92,15 @@ class Queue {
     reference back(const size_type& index = 0);
     const_reference back(const size_type& index = 0) const;
 
+    /**
+     * Segments
+     * 
+     * The queue as at most two contiguous ranges, from the most old to the most recent.
+     * second is empty if the queue does not wrap.
+     */
+    pair<span<Type>, span<Type>> segments();
+    pair<span<const Type>, span<const Type>> segments() const;
+
     /**
      * reset : Set queue as empty
      * resize : Set capacity of queue
@@ -79,6 +114,22 @@ class Queue {
     void pop();
     void push(const value_type& value);
 
+    /**
+     * Push to a full queue, and returns the popped value.
+     * Does not check about queue size.
+     */
+    value_type shift(const value_type& value);
+
+    /**
+     * Bulk pop and push
+     * 
+     * popN : pop n oldest elements.
+     * pushN : push n elements of src, oldest elements are dropped when the queue overflows.
+     * Copies at most two contiguous ranges.
+     */
+    void popN(size_type n);
+    void pushN(const value_type* src, size_type n);
+
     /**
      * Fill the queue with given value.
      */
@@ -91,19 +142,23 @@ class Queue {
      * forwardIterator should use ++ or + operator.
      * backwardIterator should use -- or - operator.
      */
-    inline QueueIterator<Type> forwardIterator() { return QueueIterator<Type>(*this, _back); }
-    inline QueueIterator<Type> backwardIterator() { return QueueIterator<Type>(*this, _front); }
-    inline QueueConstIterator<Type> forwardConstIterator() const { return QueueConstIterator<Type>{*this, _back}; }
-    inline QueueConstIterator<Type> backwardConstIterator() const { return QueueConstIterator<Type>{*this, _front}; }
+    inline QueueIterator<Type> forwardIterator() { return QueueIterator<Type>(*this, _data + _back); }
+    inline QueueIterator<Type> backwardIterator() { return QueueIterator<Type>(*this, _data + _front); }
+    inline QueueConstIterator<Type> forwardConstIterator() const { return QueueConstIterator<Type>{*this, _data + _back}; }
+    inline QueueConstIterator<Type> backwardConstIterator() const { return QueueConstIterator<Type>{*this, _data + _front}; }
 
 protected:
-    value_type _data[Extent]{};
-    size_type _capacity;                       // maximum size
-    size_type _size{0};                        // current size
-    value_type* _back{_data};                  // old index
-    value_type* _front{_data + _capacity - 1}; // recent index
+    using queue_storage<Type, Extent>::_data;
+    using queue_storage<Type, Extent>::_extent;
+    size_type _capacity;              // maximum size
+    size_type _size{0};               // current size
+    size_type _back{0};               // old index
+    size_type _front{_capacity - 1U}; // recent index
 };
 
+template<typename Type, size_t Extent>
+constexpr typename Queue<Type, Extent>::size_type Queue<Type, Extent>::extent;
+
 template<typename Type, size_t Extent>
 Queue<Type, Extent>::Queue() :
 _capacity(Extent) {}
@@ -111,61 +166,75 @@ _capacity(Extent) {}
 template<typename Type, size_t Extent>
 Queue<Type, Extent>::Queue(const size_type& capacity) :
 _capacity(capacity) {
-    assert(capacity <= Extent);
+    assert(capacity <= _extent);
 }
 
 template<typename Type, size_t Extent>
 typename Queue<Type, Extent>::reference Queue<Type, Extent>::front(const size_type& index) {
     if(index >= _size) {
         assert(false);
-        return *_back;
+        return _data[_back];
     }
 
-    return (_front - index >= _data) ? *(_front - index) : *(_front + _capacity - index);
+    return (_front >= index) ? _data[_front - index] : _data[_front + _capacity - index];
 }
 
 template<typename Type, size_t Extent>
 typename Queue<Type, Extent>::const_reference Queue<Type, Extent>::front(const size_type& index) const {
     if(index >= _size) {
         assert(false);
-        return *_back;
+        return _data[_back];
     }
 
-    return (_front - index >= _data) ? *(_front - index) : *(_front + _capacity - index);
+    return (_front >= index) ? _data[_front - index] : _data[_front + _capacity - index];
 }
 
 template<typename Type, size_t Extent>
 typename Queue<Type, Extent>::reference Queue<Type, Extent>::back(const size_type& index) {
     if(index >= _size) {
         assert(false);
-        return *_front;
+        return _data[_front];
     }
 
-    return (_back + index >= _data + _capacity) ? *(_back + index - _capacity) : *(_back + index);
+    return (_back + index >= _capacity) ? _data[_back + index - _capacity] : _data[_back + index];
 }
 
 template<typename Type, size_t Extent>
 typename Queue<Type, Extent>::const_reference Queue<Type, Extent>::back(const size_type& index) const {
     if(index >= _size) {
         assert(false);
-        return *_front;
+        return _data[_front];
     }
 
-    return (_back + index >= _data + _capacity) ? *(_back + index - _capacity) : *(_back + index);
+    return (_back + index >= _capacity) ? _data[_back + index - _capacity] : _data[_back + index];
+}
+
+template<typename Type, size_t Extent>
+pair<span<Type>, span<Type>> Queue<Type, Extent>::segments() {
+    const size_type contiguous = _capacity - _back; // elements until the end of storage
+    const size_type first = contiguous < _size ? contiguous : _size;
+    return pair<span<Type>, span<Type>>{span<Type>{_data + _back, first}, span<Type>{_data, _size - first}};
+}
+
+template<typename Type, size_t Extent>
+pair<span<const Type>, span<const Type>> Queue<Type, Extent>::segments() const {
+    const size_type contiguous = _capacity - _back; // elements until the end of storage
+    const size_type first = contiguous < _size ? contiguous : _size;
+    return pair<span<const Type>, span<const Type>>{span<const Type>{_data + _back, first}, span<const Type>{_data, _size - first}};
 }
 
 template<typename Type, size_t Extent>
 void Queue<Type, Extent>::reset() {
     _size = 0;
-    _back = _data;
-    _front = _data + _capacity - 1;
+    _back = 0;
+    _front = _capacity - 1U;
 }
 
 template<typename Type, size_t Extent>
 void Queue<Type, Extent>::resize(const size_type& size) {
-    if(size > Extent) {
+    if(size > _extent) {
         assert(false);
-        resize(Extent);
+        resize(_extent);
         return;
     }
 
@@ -185,7 +254,7 @@ void Queue<Type, Extent>::pop() {
     }
 
     --_size;
-    _back == _data + _capacity - 1 ? _back = _data : _back++;
+    _back == _capacity - 1U ? _back = 0 : _back++;
 }
 
 template<typename Type, size_t Extent>
@@ -195,15 +264,67 @@ void Queue<Type, Extent>::push(const value_type& value) {
     }
 
     ++_size;
-    _front == _data + _capacity - 1 ? _front = _data : _front++;
-    *_front = value;
+    _front == _capacity - 1U ? _front = 0 : _front++;
+    _data[_front] = value;
+}
+
+template<typename Type, size_t Extent>
+typename Queue<Type, Extent>::value_type Queue<Type, Extent>::shift(const value_type& value) {
+    const value_type result = _data[_back];
+    _back == _capacity - 1U ? _back = 0 : _back++;
+    _front == _capacity - 1U ? _front = 0 : _front++;
+    _data[_front] = value;
+    return result;
+}
+
+template<typename Type, size_t Extent>
+void Queue<Type, Extent>::popN(size_type n) {
+    if(n > _size) {
+        assert(false);
+        n = _size;
+    }
+
+    _size -= n;
+    _back += n;
+    if(_back >= _capacity) {
+        _back -= _capacity;
+    }
+}
+
+template<typename Type, size_t Extent>
+void Queue<Type, Extent>::pushN(const value_type* src, size_type n) {
+    if(n == 0) {
+        return;
+    }
+
+    if(n >= _capacity) {
+        // Only the last _capacity elements remain.
+        copy_n(src + (n - _capacity), _capacity, _data);
+        _size = _capacity;
+        _back = 0;
+        _front = _capacity - 1U;
+        return;
+    }
+
+    if(_size + n > _capacity) {
+        popN(_size + n - _capacity);
+    }
+
+    const size_type begin = (_front == _capacity - 1U) ? 0 : _front + 1U;
+    const size_type contiguous = _capacity - begin; // elements until the end of storage
+    const size_type first = contiguous < n ? contiguous : n;
+    copy_n(src, first, _data + begin);
+    copy_n(src + first, n - first, _data);
+
+    _size += n;
+    _front = (n > first) ? (n - first) - 1U : begin + first - 1U;
 }
 
 template<typename Type, size_t Extent>
 void Queue<Type, Extent>::fill(const value_type& value) {
     _size = _capacity;
-    _back = _data;
-    _front = _data + _capacity - 1;
+    _back = 0;
+    _front = _capacity - 1U;
 
     for(size_type i = 0; i < _capacity; ++i) {
         _data[i] = value;
@@ -217,7 +338,9 @@ template<typename Type>
 struct QueueIterator {
     template<size_t Extent>
     explicit QueueIterator(Queue<Type, Extent>& queue, Type* _ptr) :
-    size(queue._size), ptr(_ptr), pBegin(queue._data), pEnd(queue._data + queue.extent) {}
+    size(queue._size), ptr(_ptr), pBegin(queue._data), pEnd(queue._data + queue._capacity) {}
+    explicit QueueIterator(const size_t& _size, Type* _ptr, Type* _pBegin, Type* _pEnd) :
+    size(_size), ptr(_ptr), pBegin(_pBegin), pEnd(_pEnd) {}
     QueueIterator(const QueueIterator&) = default;
     QueueIterator(const QueueIterator<Type>& other, Type* _ptr) :
     size(other.size), ptr(_ptr), pBegin(other.pBegin), pEnd(other.pEnd) {}
@@ -278,7 +401,9 @@ template<typename Type>
 struct QueueConstIterator {
     template<size_t Extent>
     explicit QueueConstIterator(const Queue<Type, Extent>& queue, const Type* _ptr) :
-    size(queue._size), ptr(_ptr), pBegin(queue._data), pEnd(queue._data + queue.extent) {}
+    size(queue._size), ptr(_ptr), pBegin(queue._data), pEnd(queue._data + queue._capacity) {}
+    explicit QueueConstIterator(const size_t& _size, const Type* _ptr, const Type* _pBegin, const Type* _pEnd) :
+    size(_size), ptr(_ptr), pBegin(_pBegin), pEnd(_pEnd) {}
     QueueConstIterator(const QueueConstIterator&) = default;
     QueueConstIterator(const QueueConstIterator<Type>& other, const Type* _ptr) :
     size(other.size), ptr(_ptr), pBegin(other.pBegin), pEnd(other.pEnd) {}
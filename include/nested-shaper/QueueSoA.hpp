@@ -0,0 +1,284 @@
+/**
+ * @file QueueSoA.hpp
+ *
+ * @brief This file contains the definition of the QueueSoA class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for ns::array, ns::span
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+template<typename ArrayType>
+struct QueueSoAConstIterator;
+
+/**
+ * @class QueueSoA
+ *
+ * A template based structure-of-arrays queue class, interchangeable with Queue for ns::array elements.
+ * Each dimension is stored in its own lane, and every sample is mirrored into i and i + capacity of the lane.
+ * Therefore the window of each dimension is a single contiguous range, accessible by lane(m).
+ *
+ * Accessors return elements by value, as elements are gathered from lanes.
+ *
+ * @tparam ArrayType ns::array<Type, Dimension>
+ * @tparam Extent Maximum extent of the queue.
+ */
+template<typename ArrayType, size_t Extent>
+class QueueSoA;
+
+template<typename Type, size_t Dimension, size_t Extent>
+class QueueSoA<array<Type, Dimension>, Extent> {
+public:
+    using value_type = array<Type, Dimension>;
+    using size_type = size_t;
+    static constexpr size_type extent = Extent;
+    static constexpr size_type dimension = Dimension;
+    static constexpr size_type stride = 2U * Extent; // distance between lanes
+
+    template<typename _ArrayType>
+    friend struct QueueSoAConstIterator;
+
+    /**
+     * Constructors
+     */
+    QueueSoA();
+    explicit QueueSoA(const size_type& capacity);
+
+    /**
+     * Status of the queue
+     */
+    inline bool isEmpty() const { return _size == 0; }
+    inline bool isFull() const { return _size == _capacity; }
+    inline size_type capacity() const { return _capacity; }
+    inline size_type size() const { return _size; }
+
+    /**
+     * Accessors
+     *
+     * front : retrieve from the most recent index
+     * back : retrieve from the most old index
+     * lane : contiguous range of m-th dimension, from the most old to the most recent.
+     */
+    inline value_type front(const size_type& index = 0) const {
+        assert(index < _size);
+        return gather(_back + _size - 1U - index);
+    }
+    inline value_type back(const size_type& index = 0) const {
+        assert(index < _size);
+        return gather(_back + index);
+    }
+    inline span<const Type> lane(const size_type& m) const { return span<const Type>{_data + m * stride + _back, _size}; }
+
+    /**
+     * reset : Set queue as empty
+     * resize : Set capacity of queue
+     */
+    void reset();
+    void resize(const size_type& size);
+
+    /**
+     * Pop and Push
+     */
+    void pop();
+    void push(const value_type& value);
+
+    /**
+     * Push to a full queue, and returns the popped value.
+     * Does not check about queue size.
+     */
+    value_type shift(const value_type& value);
+
+    /**
+     * Fill the queue with given value.
+     */
+    void fill(const value_type& value);
+
+    /**
+     * Iterators
+     *
+     * Warnings :
+     * forwardIterator should use ++ or + operator.
+     * backwardIterator should use -- or - operator.
+     */
+    inline QueueSoAConstIterator<value_type> forwardConstIterator() const { return QueueSoAConstIterator<value_type>{*this, _back}; }
+    inline QueueSoAConstIterator<value_type> backwardConstIterator() const { return QueueSoAConstIterator<value_type>{*this, _back + _size - 1U}; }
+
+protected:
+    Type _data[Dimension * stride]{}; // lanes of 2 * Extent elements
+    size_type _capacity;              // maximum size
+    size_type _size{0};               // current size
+    size_type _back{0};               // old index, always less than _capacity
+
+    inline value_type gather(const size_type& index) const {
+        value_type value;
+        for(size_type m = 0; m < Dimension; m++) {
+            value[m] = _data[m * stride + index];
+        }
+
+        return value;
+    }
+
+    inline void write(const size_type& index, const value_type& value) {
+        for(size_type m = 0; m < Dimension; m++) {
+            _data[m * stride + index] = value[m];
+            _data[m * stride + index + _capacity] = value[m];
+        }
+    }
+};
+
+template<typename Type, size_t Dimension, size_t Extent>
+constexpr typename QueueSoA<array<Type, Dimension>, Extent>::size_type QueueSoA<array<Type, Dimension>, Extent>::extent;
+template<typename Type, size_t Dimension, size_t Extent>
+constexpr typename QueueSoA<array<Type, Dimension>, Extent>::size_type QueueSoA<array<Type, Dimension>, Extent>::dimension;
+template<typename Type, size_t Dimension, size_t Extent>
+constexpr typename QueueSoA<array<Type, Dimension>, Extent>::size_type QueueSoA<array<Type, Dimension>, Extent>::stride;
+
+template<typename Type, size_t Dimension, size_t Extent>
+QueueSoA<array<Type, Dimension>, Extent>::QueueSoA() :
+_capacity(Extent) {}
+
+template<typename Type, size_t Dimension, size_t Extent>
+QueueSoA<array<Type, Dimension>, Extent>::QueueSoA(const size_type& capacity) :
+_capacity(capacity) {
+    assert(capacity <= Extent);
+}
+
+template<typename Type, size_t Dimension, size_t Extent>
+void QueueSoA<array<Type, Dimension>, Extent>::reset() {
+    _size = 0;
+    _back = 0;
+}
+
+template<typename Type, size_t Dimension, size_t Extent>
+void QueueSoA<array<Type, Dimension>, Extent>::resize(const size_type& size) {
+    if(size > Extent) {
+        assert(false);
+        resize(Extent);
+        return;
+    }
+
+    if(size == _capacity) {
+        return;
+    }
+
+    _capacity = size;
+    reset();
+}
+
+template<typename Type, size_t Dimension, size_t Extent>
+void QueueSoA<array<Type, Dimension>, Extent>::pop() {
+    if(isEmpty()) {
+        assert(false);
+        return;
+    }
+
+    --_size;
+    _back == _capacity - 1U ? _back = 0 : _back++;
+}
+
+template<typename Type, size_t Dimension, size_t Extent>
+void QueueSoA<array<Type, Dimension>, Extent>::push(const value_type& value) {
+    if(isFull()) {
+        pop();
+    }
+
+    const size_type index = _back + _size;
+    write(index >= _capacity ? index - _capacity : index, value);
+    ++_size;
+}
+
+template<typename Type, size_t Dimension, size_t Extent>
+typename QueueSoA<array<Type, Dimension>, Extent>::value_type QueueSoA<array<Type, Dimension>, Extent>::shift(const value_type& value) {
+    const value_type result = gather(_back);
+    write(_back, value);
+    _back == _capacity - 1U ? _back = 0 : _back++;
+    return result;
+}
+
+template<typename Type, size_t Dimension, size_t Extent>
+void QueueSoA<array<Type, Dimension>, Extent>::fill(const value_type& value) {
+    _size = _capacity;
+    _back = 0;
+
+    for(size_type m = 0; m < Dimension; m++) {
+        for(size_type i = 0; i < 2U * _capacity; ++i) {
+            _data[m * stride + i] = value[m];
+        }
+    }
+}
+
+/**
+ * Const iterator of structure-of-arrays queue.
+ * Dereference gathers an element from lanes, lane(m) provides contiguous range of m-th dimension.
+ */
+template<typename ArrayType>
+struct QueueSoAConstIterator;
+
+template<typename Type, size_t Dimension>
+struct QueueSoAConstIterator<array<Type, Dimension>> {
+    using value_type = array<Type, Dimension>;
+
+    template<size_t Extent>
+    explicit QueueSoAConstIterator(const QueueSoA<value_type, Extent>& queue, const size_t& index) :
+    size(queue._size), ptr(queue._data + index), pBegin(queue._data + queue._back), stride(queue.stride) {}
+    QueueSoAConstIterator(const QueueSoAConstIterator&) = default;
+    QueueSoAConstIterator(const QueueSoAConstIterator<value_type>& other, const Type* _ptr) :
+    size(other.size), ptr(_ptr), pBegin(other.pBegin), stride(other.stride) {}
+
+    inline value_type operator*() const {
+        value_type value;
+        for(size_t m = 0; m < Dimension; m++) {
+            value[m] = ptr[m * stride];
+        }
+
+        return value;
+    }
+
+    inline QueueSoAConstIterator& operator++() {
+        ++ptr;
+        return *this;
+    }
+    inline QueueSoAConstIterator operator++(int) {
+        QueueSoAConstIterator tmp(*this);
+        operator++();
+        return tmp;
+    }
+    inline QueueSoAConstIterator& operator--() {
+        --ptr;
+        return *this;
+    }
+    inline QueueSoAConstIterator operator--(int) {
+        QueueSoAConstIterator tmp(*this);
+        operator--();
+        return tmp;
+    }
+
+    inline QueueSoAConstIterator operator+(const size_t& n) const { return QueueSoAConstIterator{*this, ptr + n}; }
+    inline void operator+=(const size_t& n) { ptr += n; }
+    inline QueueSoAConstIterator operator-(const size_t& n) const { return QueueSoAConstIterator{*this, ptr - n}; }
+    inline void operator-=(const size_t& n) { ptr -= n; }
+
+    inline bool operator==(const QueueSoAConstIterator& other) const {
+        return ptr == other.ptr;
+    }
+
+    /**
+     * Contiguous range of m-th dimension of the whole queue, from the most old to the most recent.
+     */
+    inline span<const Type> lane(const size_t& m) const { return span<const Type>{pBegin + m * stride, size}; }
+
+    const size_t size;
+
+private:
+    const Type* ptr;
+    const Type* const pBegin;
+    const size_t stride;
+};
+
+}; // namespace ns
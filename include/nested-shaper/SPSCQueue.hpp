@@ -0,0 +1,229 @@
+/**
+ * @file SPSCQueue.hpp
+ *
+ * @brief This file contains the definition of the SPSCQueue class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "tiny_utility.hpp" // for NESTED_SHAPER_CACHE_LINE_SIZE
+#include <stddef.h>
+#include <assert.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+// Ordering of the plain (/volatile:iso) accesses, a full barrier on ARM and a compiler barrier on x86 and x64.
+#if defined(_M_ARM) || defined(_M_ARM64) || defined(_M_ARM64EC)
+#define NESTED_SHAPER_SPSC_BARRIER() __dmb(0xB) // inner shareable
+#else
+#define NESTED_SHAPER_SPSC_BARRIER() _ReadWriteBarrier()
+#endif
+#else
+#error "SPSCQueue requires acquire / release atomics, which are implemented for GCC, Clang and MSVC."
+#endif
+
+namespace ns {
+/**
+ * @class SPSCQueue
+ *
+ * A template based wait-free single-producer / single-consumer queue.
+ * Samples are stored in a fixed array like Queue, indices are increased monotonically.
+ * Each index is written by one thread only, and is placed on its own cache line.
+ *
+ * push must be called only from the producer thread, pop and reset only from the consumer thread.
+ *
+ * Indices are loaded with acquire and stored with release semantics, by __atomic builtins of GCC and Clang,
+ * and by __iso_volatile loads and stores with barriers on MSVC, whatever /volatile is. Other compilers are not supported.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam Extent Maximum extent of the queue.
+ */
+template<typename Type, size_t Extent>
+class SPSCQueue {
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    static constexpr size_type extent = Extent;
+
+    /**
+     * Status of the queue, approximated while the other thread is running.
+     */
+    inline bool isEmpty() const { return size() == 0; }
+    inline size_type capacity() const { return Extent; }
+    inline size_type size() const { return load(_head) - load(_tail); }
+
+    /**
+     * Producer : returns false if the queue is full.
+     */
+    bool push(const value_type& value);
+
+    /**
+     * Consumer : returns false if the queue is empty.
+     */
+    bool pop(value_type& value);
+
+    /**
+     * Consumer : discard every pending element.
+     */
+    void reset();
+
+protected:
+    alignas(NESTED_SHAPER_CACHE_LINE_SIZE) size_type _head{0}; // written by producer
+    size_type _tail_cache{0};                                   // producer's copy of _tail
+    alignas(NESTED_SHAPER_CACHE_LINE_SIZE) size_type _tail{0}; // written by consumer
+    size_type _head_cache{0};                                   // consumer's copy of _head
+    alignas(NESTED_SHAPER_CACHE_LINE_SIZE) value_type _data[Extent]{};
+
+    static inline size_type load(const size_type& index) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#elif defined(_WIN64)
+        const size_type value = static_cast<size_type>(__iso_volatile_load64(reinterpret_cast<const volatile __int64*>(&index)));
+        NESTED_SHAPER_SPSC_BARRIER();
+        return value;
+#else
+        const size_type value = static_cast<size_type>(__iso_volatile_load32(reinterpret_cast<const volatile __int32*>(&index)));
+        NESTED_SHAPER_SPSC_BARRIER();
+        return value;
+#endif
+    }
+    static inline void store(size_type& index, const size_type& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#elif defined(_WIN64)
+        NESTED_SHAPER_SPSC_BARRIER();
+        __iso_volatile_store64(reinterpret_cast<volatile __int64*>(&index), static_cast<__int64>(value));
+#else
+        NESTED_SHAPER_SPSC_BARRIER();
+        __iso_volatile_store32(reinterpret_cast<volatile __int32*>(&index), static_cast<__int32>(value));
+#endif
+    }
+};
+
+template<typename Type, size_t Extent>
+constexpr typename SPSCQueue<Type, Extent>::size_type SPSCQueue<Type, Extent>::extent;
+
+template<typename Type, size_t Extent>
+bool SPSCQueue<Type, Extent>::push(const value_type& value) {
+    const size_type head = _head; // only producer writes _head
+
+    if(head - _tail_cache == Extent) {
+        _tail_cache = load(_tail);
+        if(head - _tail_cache == Extent) {
+            return false;
+        }
+    }
+
+    _data[head % Extent] = value;
+    store(_head, head + 1U);
+    return true;
+}
+
+template<typename Type, size_t Extent>
+bool SPSCQueue<Type, Extent>::pop(value_type& value) {
+    const size_type tail = _tail; // only consumer writes _tail
+
+    if(tail == _head_cache) {
+        _head_cache = load(_head);
+        if(tail == _head_cache) {
+            return false;
+        }
+    }
+
+    value = _data[tail % Extent];
+    store(_tail, tail + 1U);
+    return true;
+}
+
+template<typename Type, size_t Extent>
+void SPSCQueue<Type, Extent>::reset() {
+    _head_cache = load(_head);
+    store(_tail, _head_cache);
+}
+
+/**
+ * @class ShaperPipeline
+ *
+ * Hands setpoints from a producer thread (e.g. trajectory planner) to a shaper on a consumer thread (e.g. real-time loop).
+ * tick consumes one pending setpoint, or holds the last setpoint when the producer is late.
+ * Setpoints are samples at the rate of tick, so pending setpoints are kept for the next ticks, not skipped.
+ * tickLatest drains every pending setpoint and convolutes only the most recent one,
+ * for producers which submit targets faster than the rate of tick.
+ *
+ * @tparam Shaper ShaperMetrics (or any class with value_type and convolute(value, dt))
+ * @tparam Extent Maximum number of pending setpoints.
+ */
+template<typename Shaper, size_t Extent>
+class ShaperPipeline {
+public:
+    using value_type = typename Shaper::value_type;
+    using size_type = size_t;
+
+    /**
+     * Constructors, arguments are forwarded to the shaper.
+     */
+    template<typename... Args>
+    explicit ShaperPipeline(const value_type& value, const Args&... capacities) :
+    shaper(value, capacities...), last(value) {}
+
+    /**
+     * (Re)Initializers, consumer thread only.
+     * Pending setpoints are discarded.
+     */
+    template<typename... Args>
+    void initialize(const value_type& value, const Args&... capacities) {
+        channel.reset();
+        shaper.initialize(value, capacities...);
+        last = value;
+        _underruns = 0;
+    }
+
+    /**
+     * Producer : returns false if the channel is full.
+     */
+    inline bool submit(const value_type& setpoint) { return channel.push(setpoint); }
+
+    /**
+     * Consumer : convolute the next setpoint, or the last one if no setpoint is pending.
+     */
+    template<typename TimeType>
+    auto tick(const TimeType& dt) {
+        if(!channel.pop(last)) {
+            ++_underruns;
+        }
+
+        return shaper.convolute(last, dt);
+    }
+
+    /**
+     * Consumer : convolute the most recent setpoint, older pending setpoints are discarded.
+     */
+    template<typename TimeType>
+    auto tickLatest(const TimeType& dt) {
+        if(!channel.pop(last)) {
+            ++_underruns;
+        }
+
+        while(channel.pop(last)) {
+        }
+
+        return shaper.convolute(last, dt);
+    }
+
+    /**
+     * Number of ticks, which held the last setpoint.
+     */
+    inline size_type underruns() const { return _underruns; }
+
+protected:
+    SPSCQueue<value_type, Extent> channel{};
+    Shaper shaper;
+    value_type last;
+    size_type _underruns{0};
+};
+
+}; // namespace ns
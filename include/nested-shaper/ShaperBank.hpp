@@ -0,0 +1,252 @@
+/**
+ * @file ShaperBank.hpp
+ *
+ * @brief This file contains the definition of the ShaperBank class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "ShaperMetrics.hpp"                                  // for ns::DerivativeBuffers
+#include "metrics/central_finite_difference_coefficients.hpp" // for ns::CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS
+#include "tiny_utility.hpp"                                   // for ns::sum_of, NESTED_SHAPER_CACHE_LINE_SIZE, NESTED_SHAPER_RESTRICT
+#include <stddef.h>
+#include <assert.h>
+#include <math.h>
+
+namespace ns {
+/**
+ * @class ShaperBank
+ *
+ * Independent NestedShaperEuclideanRecursive of Channels channels, with the same extents and capacities.
+ * Every ring, mean and compensation term is interleaved across channels, e.g. _rings[slot][channel],
+ * and ring indices are shared, so each step of convolute is a branchless loop over contiguous channels without aliasing,
+ * which compilers may vectorize without intrinsics, e.g. GCC -O3 (or -O2 -ftree-vectorize) with -mavx2.
+ * See benchmark/shaper_bank.cpp to check the stage loop is vectorized for a target.
+ * Results of each channel are the same as NestedShaperEuclideanRecursive.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam Channels Number of channels.
+ * @tparam DerivativeOrder Number of results, position and DerivativeOrder - 1 derivatives.
+ * @tparam Extent, Extents Maximum extent of each stage.
+ */
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+class alignas(NESTED_SHAPER_CACHE_LINE_SIZE) ShaperBank {
+    static_assert(Channels > 0, "Number of channels must be greater than 0.");
+    static_assert(DerivativeOrder > 1, "DerivativeOrder must be greater than 1.");
+
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    static constexpr size_type channels = Channels;
+    static constexpr size_type stages = 1U + sizeof...(Extents);
+    static constexpr size_type extents[stages] = {Extent, Extents...};
+
+    /**
+     * Constructors
+     */
+    explicit ShaperBank(const Type& value) { initialize(value); }
+    template<typename... Args>
+    explicit ShaperBank(const Type& value, const Args&... capacities) { initialize(value, capacities...); }
+
+    /**
+     * Capacity of the given stage
+     */
+    inline size_type capacity(const size_type& stage) const { return _capacities[stage]; }
+
+    /**
+     * (Re)Initializers
+     *
+     * initialize : every channel is filled with given value, or values[channel].
+     * initializeChannel : only the given channel is filled with value, others are not changed.
+     */
+    void initialize(const Type& value);
+    void initialize(const Type* values);
+    template<typename... Args>
+    void initialize(const Type& value, const Args&... capacities);
+    void initializeChannel(const size_type& channel, const Type& value);
+
+    /**
+     * Convolute
+     *
+     * inputs[channel] of every channel is convoluted.
+     * outputs.orders[k][channel] is the k-th derivative of the channel.
+     */
+    template<typename TimeType>
+    void convolute(const Type* inputs, const TimeType& dt, const DerivativeBuffers<Type, DerivativeOrder>& outputs);
+
+protected:
+    // Per stage state, interleaved across channels.
+    Type _means[stages][Channels]{};                   // Mean(average) value
+    Type _compensations[stages][Channels]{};           // Running compensation of means
+    size_type _backs[stages]{};                        // old index of the ring
+    size_type _capacities[stages]{Extent, Extents...}; // size of the ring
+
+    // Last DerivativeOrder means of the last stage, _derivatives[_back] is the oldest.
+    Type _derivatives[DerivativeOrder][Channels]{};
+    size_type _back{0};
+
+    // Rings of every stage, the ring of stage s starts after extents of stages before s.
+    Type _rings[sum_of(Extent, Extents...)][Channels]{};
+
+    // A step of a stage for every channel, values are inputs and become outputs of the stage.
+    static void convoluteStage(Type* NESTED_SHAPER_RESTRICT slot,
+                               Type* NESTED_SHAPER_RESTRICT means,
+                               Type* NESTED_SHAPER_RESTRICT compensations,
+                               Type* NESTED_SHAPER_RESTRICT values,
+                               const Type capacity);
+};
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+constexpr typename ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::size_type ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::channels;
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+constexpr typename ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::size_type ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::stages;
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+constexpr typename ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::size_type ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::extents[stages];
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+void ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::initialize(const Type& value) {
+    for(size_type s = 0; s < stages; ++s) {
+        _backs[s] = 0;
+    }
+    _back = 0;
+
+    for(size_type c = 0; c < Channels; ++c) {
+        initializeChannel(c, value);
+    }
+}
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+void ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::initialize(const Type* values) {
+    for(size_type s = 0; s < stages; ++s) {
+        _backs[s] = 0;
+    }
+    _back = 0;
+
+    for(size_type c = 0; c < Channels; ++c) {
+        initializeChannel(c, values[c]);
+    }
+}
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+template<typename... Args>
+void ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::initialize(const Type& value, const Args&... capacities) {
+    static_assert(sizeof...(capacities) == stages, "Number of capacities must be equal to number of extents.");
+    const size_type capacities_[stages] = {static_cast<size_type>(capacities)...};
+
+    for(size_type s = 0; s < stages; ++s) {
+        if(capacities_[s] > extents[s] || capacities_[s] == 0) {
+            assert(false);
+            _capacities[s] = extents[s];
+            continue;
+        }
+
+        _capacities[s] = capacities_[s];
+    }
+
+    initialize(value);
+}
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+void ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::initializeChannel(const size_type& channel, const Type& value) {
+    if(channel >= Channels) {
+        assert(false);
+        return;
+    }
+
+    // Every slot is filled, so the channel does not depend on shared ring indices.
+    Type(*ring)[Channels] = _rings;
+    for(size_type s = 0; s < stages; ++s) {
+        _means[s][channel] = value;
+        _compensations[s][channel] = Type(0);
+
+        for(size_type i = 0; i < _capacities[s]; ++i) {
+            ring[i][channel] = value;
+        }
+
+        ring += extents[s];
+    }
+
+    for(size_type i = 0; i < DerivativeOrder; ++i) {
+        _derivatives[i][channel] = value;
+    }
+}
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+void ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::convoluteStage(Type* NESTED_SHAPER_RESTRICT slot,
+                                                                                     Type* NESTED_SHAPER_RESTRICT means,
+                                                                                     Type* NESTED_SHAPER_RESTRICT compensations,
+                                                                                     Type* NESTED_SHAPER_RESTRICT values,
+                                                                                     const Type capacity) {
+    // Kahan-Babushka-Neumaier step as selects instead of branches, so the loop is vectorized.
+    for(size_type c = 0; c < Channels; ++c) {
+        const Type popped = slot[c];
+        slot[c] = values[c];
+
+        const Type mean = means[c];
+        const Type value = (values[c] - popped) / capacity;
+        const Type t = mean + value;
+        const bool larger = ::fabs(mean) >= ::fabs(value);
+        const Type big = larger ? mean : value;
+        const Type small = larger ? value : mean;
+        const Type compensation = compensations[c] + ((big - t) + small);
+        compensations[c] = compensation;
+        means[c] = t + compensation;
+        values[c] = t + compensation;
+    }
+}
+
+template<typename Type, size_t Channels, size_t DerivativeOrder, size_t Extent, size_t... Extents>
+template<typename TimeType>
+void ShaperBank<Type, Channels, DerivativeOrder, Extent, Extents...>::convolute(const Type* inputs, const TimeType& dt, const DerivativeBuffers<Type, DerivativeOrder>& outputs) {
+    Type values[Channels];
+    for(size_type c = 0; c < Channels; ++c) {
+        values[c] = inputs[c];
+    }
+
+    // Same as EuclideanMeanRecursiveMetrics of every stage, channel by channel.
+    Type(*ring)[Channels] = _rings;
+    for(size_type s = 0; s < stages; ++s) {
+        size_type& back = _backs[s];
+        convoluteStage(ring[back], _means[s], _compensations[s], values, Type(_capacities[s]));
+        back == _capacities[s] - 1U ? back = 0 : back++;
+        ring += extents[s];
+    }
+
+    // Same as EuclideanDerivativeMetrics, from the oldest sample.
+    Type* const newest = _derivatives[_back];
+    for(size_type c = 0; c < Channels; ++c) {
+        newest[c] = values[c];
+    }
+    _back == DerivativeOrder - 1U ? _back = 0 : _back++;
+
+    for(size_type c = 0; c < Channels; ++c) {
+        outputs.orders[0][c] = _derivatives[(_back + DerivativeOrder / 2U) % DerivativeOrder][c]; // Central point
+    }
+
+    Type dtn = Type(dt);
+    static constexpr array<array<Type, DerivativeOrder>, DerivativeOrder - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, DerivativeOrder>::value;
+    for(size_type i = 0; i < DerivativeOrder - 1U; ++i) {
+        Type* const output = outputs.orders[i + 1U];
+        for(size_type c = 0; c < Channels; ++c) {
+            output[c] = Type(0);
+        }
+
+        for(size_type j = 0; j < DerivativeOrder; ++j) {
+            const Type coefficient = coefficients[i][j];
+            const Type* const samples = _derivatives[(_back + j) % DerivativeOrder];
+            for(size_type c = 0; c < Channels; ++c) {
+                output[c] += coefficient * samples[c];
+            }
+        }
+
+        for(size_type c = 0; c < Channels; ++c) {
+            output[c] /= dtn;
+        }
+        dtn *= Type(dt);
+    }
+}
+
+}; // namespace ns
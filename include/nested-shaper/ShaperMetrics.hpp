@@ -11,6 +11,50 @@
 #include "MovingMetrics.hpp"
 
 namespace ns {
+/**
+ * Output buffers of convoluteBatch, one contiguous buffer for each derivative order.
+ * orders[k][i] is the k-th derivative of the i-th sample, as value_type of the shaper (array<Type, M> for arrays).
+ */
+template<typename Type, size_t N>
+struct DerivativeBuffers {
+    Type* orders[N];
+};
+
+/**
+ * Write derivatives of the i-th sample to buffers, derivatives[k] for scalars and derivatives[m][k] for arrays.
+ */
+template<typename Type, size_t N>
+inline void scatter_derivatives(const array<Type, N>& derivatives, const DerivativeBuffers<Type, N>& buffers, const size_t& i) {
+    for(size_t k = 0; k < N; ++k) {
+        buffers.orders[k][i] = derivatives[k];
+    }
+}
+
+template<typename Type, size_t N, size_t M>
+inline void scatter_derivatives(const array<array<Type, N>, M>& derivatives, const DerivativeBuffers<array<Type, M>, N>& buffers, const size_t& i) {
+    for(size_t k = 0; k < N; ++k) {
+        array<Type, M>& output = buffers.orders[k][i];
+        for(size_t m = 0; m < M; ++m) {
+            output[m] = derivatives[m][k];
+        }
+    }
+}
+
+/**
+ * DerivativeMetrics functor may provide initialize(dt), which is called with a fixed time step,
+ * e.g. coefficients divided by dt^k once (EuclideanDerivativeFixedDtMetrics, see FixedDtShaperMetrics).
+ */
+template<typename Metrics, typename TimeType>
+inline auto initialize_derivative_metrics(Metrics& metrics, const TimeType& dt, int) -> decltype(metrics.initialize(dt), void()) {
+    metrics.initialize(dt);
+}
+
+template<typename Metrics, typename TimeType>
+inline void initialize_derivative_metrics(Metrics& metrics, const TimeType& dt, long) {
+    (void)metrics;
+    (void)dt;
+}
+
 /**
  * @class ShaperMetrics
  * 
@@ -32,26 +76,33 @@ namespace ns {
  * struct DerivativeMetrics {
  *  ResultType operator()(QueueConstIterator<Type> forwardIterator, QueueConstIterator<Type> backwardIterator, const TimeType& dt) const { return [as ResultType]; }
  * };
+ * 
+ * BasicShaperMetrics is the generalized form of ShaperMetrics.
+ * DerivativeQueue is a queue of last DerivativeMetrics samples. (Queue<Type, Extent>, PowerOfTwoQueue<Type, Extent>)
+ * Nested is nested moving metrics, which should have the same interface with BasicMovingMetricsNested.
+ * Arguments after the value of constructor are forwarded to Nested.
  */
-template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
-class ShaperMetrics : protected Queue<Type, Extent>, protected MovingMetricsNested<Type, MeanMetrics, Extents...> {
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+class BasicShaperMetrics : protected DerivativeQueue, protected Nested {
 public:
     using value_type = Type;
     using reference = Type&;
     using const_reference = const Type&;
     using size_type = size_t;
+    using derivative_metrics_type = DerivativeMetrics;
+    using derivative_queue_type = DerivativeQueue;
 
     /**
      * Constructors
      */
-    explicit ShaperMetrics(const Type& value);
+    explicit BasicShaperMetrics(const Type& value);
     template<typename... Args>
-    explicit ShaperMetrics(const Type& value, const Args&... capacities);
+    explicit BasicShaperMetrics(const Type& value, Args&&... capacities);
 
     /**
      * Status of the queue
      */
-    using Queue<Type, Extent>::capacity;
+    using DerivativeQueue::capacity;
 
     /**
      * (Re)Initializers
@@ -66,45 +117,235 @@ class ShaperMetrics : protected Queue<Type, Extent>, protected MovingMetricsNest
     template<typename TimeType>
     auto convolute(const Type& input, const TimeType& dt);
 
+    /**
+     * Sub-sample output
+     *
+     * Position and derivatives at fraction * dt after the last result of convolute, fraction in [0, 1].
+     * The last samples of the derivative queue are a polynomial of degree capacity() - 1, whose Taylor series is evaluated,
+     * so evaluate(0, dt) is the last result. With central differences (e.g. EuclideanDerivativeMetrics), the result is at
+     * a sample within the queue, and position of evaluate(1, dt) is position of the next result (if capacity() > 2,
+     * with capacity() == 2 the central sample 2 / 2 is the latest one and evaluate extrapolates).
+     * With backward differences (e.g. EuclideanDerivativeBackwardMetrics), the result is at the latest sample,
+     * so evaluate extrapolates the polynomial past it, and evaluate(1, dt) is a prediction of the next result.
+     * The state is not changed, e.g. a servo loop at a multiple of the rate of convolute may call evaluate at every tick.
+     */
+    template<typename TimeType>
+    auto evaluate(const TimeType& fraction, const TimeType& dt) const;
+
+    /**
+     * Convolute a block of n samples, same as n calls of convolute.
+     * Nested moving metrics run stage by stage over chunks of NESTED_SHAPER_BLOCK_SIZE samples.
+     * output[i] is the result of convolute(input[i], dt).
+     */
+    template<typename TimeType, typename ResultType>
+    void convoluteBlock(const Type* input, ResultType* output, size_type n, const TimeType& dt);
+
+    /**
+     * Convolute a batch of n samples, same as convoluteBlock, but derivatives are written to buffers of each order.
+     * e.g. buffers.orders[0] receives n positions, buffers.orders[1] n velocities, without transposition by the caller.
+     */
+    template<typename TimeType, size_t N>
+    void convoluteBatch(const Type* input, size_type n, const TimeType& dt, const DerivativeBuffers<Type, N>& buffers);
+
+    /**
+     * Decimation (multi-rate)
+     *
+     * convoluteDecimated convolutes every input sample through nested moving metrics,
+     * but evaluates derivatives only once every decimation() samples, and returns the number of outputs.
+     * Derivative queue is updated only with the samples just before each output, which are enough for the derivatives,
+     * and with every sample after the last output of the call, so that the queue has no gap at the end of any call.
+     * Outputs are the same as every decimation()-th result of convolute, counted from initialize or setDecimation,
+     * also when convolute, convoluteBlock or convoluteBatch are called in between, as they advance the phase too.
+     */
+    inline size_type decimation() const { return _decimation; }
+    void setDecimation(size_type factor);
+    template<typename TimeType, typename ResultType>
+    size_type convoluteDecimated(const Type* input, ResultType* output, size_type n, const TimeType& dt);
+
+    /**
+     * Composite kernel
+     *
+     * Nested moving averages are a single FIR filter, the convolution of boxes of every stage.
+     * kernel writes kernelSize() coefficients, for scalar floating point Type and euclidean mean metrics.
+     * Nested should provide kernelSize() and convoluteKernel(kernel, size), as BasicMovingMetricsNested,
+     * FusedMovingMetricsNested and ArenaMovingMetricsNested do. CICMovingMetricsNested does not, as its Type is an integer.
+     * shape_offline (OfflineConvolution.hpp) convolutes a whole recording with this kernel.
+     */
+    inline size_type kernelSize() const { return Nested::kernelSize(); }
+    void kernel(Type* output) const;
+
+    /**
+     * Snapshot and Restore
+     * 
+     * The whole state is copied by a single memcpy, e.g. to evaluate several branches from the same state.
+     * Every member should be trivially copyable, which is not the case for ArenaShaperMetrics.
+     */
+    using state_type = state_block<BasicShaperMetrics>;
+    inline state_type snapshot() const {
+        state_type state;
+        save_state(*this, state);
+        return state;
+    }
+    inline void restore(const state_type& state) { load_state(*this, state); }
+
 protected:
     DerivativeMetrics derivative_metrics{}; // DerivativeMetrics functor
-    using Queue<Type, Extent>::fill;
+    size_type _decimation{1};               // number of input samples per output of convoluteDecimated
+    size_type _phase{0};                    // number of input samples since the last output
+    using DerivativeQueue::fill;
+
+private:
+    // Convolute n samples through nested moving metrics by chunks of NESTED_SHAPER_BLOCK_SIZE,
+    // sink(i, position) is called with the output of the i-th sample, in order.
+    template<typename Sink>
+    void convoluteChunks(const Type* input, size_type n, Sink&& sink);
 };
 
-template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
-ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>::ShaperMetrics(const Type& value) :
-Queue<Type, Extent>(), MovingMetricsNested<Type, MeanMetrics, Extents...>(value) {
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::BasicShaperMetrics(const Type& value) :
+DerivativeQueue(), Nested(value) {
     fill(value);
 }
 
-template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
 template<typename... Args>
-ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>::ShaperMetrics(const Type& value, const Args&... capacities) :
-Queue<Type, Extent>(), MovingMetricsNested<Type, MeanMetrics, Extents...>(value, capacities...) {
+BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::BasicShaperMetrics(const Type& value, Args&&... capacities) :
+DerivativeQueue(), Nested(value, static_cast<Args&&>(capacities)...) {
     fill(value);
 }
 
-template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
-void ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>::initialize(const Type& value) {
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::initialize(const Type& value) {
     derivative_metrics = DerivativeMetrics{};
+    _phase = 0;
     fill(value);
-    MovingMetricsNested<Type, MeanMetrics, Extents...>::initialize(value);
+    Nested::initialize(value);
 }
 
-template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
 template<typename... Args>
-void ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>::initialize(const Type& value, const Args&... capacities) {
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::initialize(const Type& value, const Args&... capacities) {
     derivative_metrics = DerivativeMetrics{};
+    _phase = 0;
     fill(value);
-    MovingMetricsNested<Type, MeanMetrics, Extents...>::initialize(value, capacities...);
+    Nested::initialize(value, capacities...);
 }
 
-template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
 template<typename TimeType>
-auto ShaperMetrics<Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>::convolute(const Type& input, const TimeType& dt) {
-    Queue<Type, Extent>::push(MovingMetricsNested<Type, MeanMetrics, Extents...>::convolute(input));
-    return derivative_metrics.template operator()(Queue<Type, Extent>::forwardConstIterator(),
-                                                  Queue<Type, Extent>::backwardConstIterator(),
+auto BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::convolute(const Type& input, const TimeType& dt) {
+    DerivativeQueue::push(Nested::convolute(input));
+    if(++_phase == _decimation) {
+        _phase = 0;
+    }
+    return derivative_metrics.template operator()(DerivativeQueue::forwardConstIterator(),
+                                                  DerivativeQueue::backwardConstIterator(),
                                                   dt);
 }
-}; // namespace ns
\ No newline at end of file
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+template<typename TimeType>
+auto BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::evaluate(const TimeType& fraction, const TimeType& dt) const {
+    assert(TimeType(0) <= fraction && fraction <= TimeType(1));
+    return taylor_shift(derivative_metrics.template operator()(DerivativeQueue::forwardConstIterator(),
+                                                               DerivativeQueue::backwardConstIterator(),
+                                                               dt),
+                        fraction * dt);
+}
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+template<typename Sink>
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::convoluteChunks(const Type* input, size_type n, Sink&& sink) {
+    Type block[NESTED_SHAPER_BLOCK_SIZE];
+    size_type offset{0};
+
+    while(n > 0) {
+        const size_type chunk = n < NESTED_SHAPER_BLOCK_SIZE ? n : NESTED_SHAPER_BLOCK_SIZE;
+        Nested::convoluteBlock(input, block, chunk);
+
+        for(size_type i = 0; i < chunk; ++i) {
+            sink(offset + i, block[i]);
+        }
+
+        input += chunk;
+        offset += chunk;
+        n -= chunk;
+    }
+}
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+template<typename TimeType, typename ResultType>
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::convoluteBlock(const Type* input, ResultType* output, size_type n, const TimeType& dt) {
+    _phase = (_phase + n) % _decimation;
+    convoluteChunks(input, n, [&](const size_type& i, const Type& position) {
+        DerivativeQueue::push(position);
+        output[i] = derivative_metrics.template operator()(DerivativeQueue::forwardConstIterator(),
+                                                           DerivativeQueue::backwardConstIterator(),
+                                                           dt);
+    });
+}
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+template<typename TimeType, size_t N>
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::convoluteBatch(const Type* input, size_type n, const TimeType& dt, const DerivativeBuffers<Type, N>& buffers) {
+    _phase = (_phase + n) % _decimation;
+    convoluteChunks(input, n, [&](const size_type& i, const Type& position) {
+        DerivativeQueue::push(position);
+        scatter_derivatives(derivative_metrics.template operator()(DerivativeQueue::forwardConstIterator(),
+                                                                   DerivativeQueue::backwardConstIterator(),
+                                                                   dt),
+                            buffers, i);
+    });
+}
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::setDecimation(size_type factor) {
+    if(factor == 0) {
+        assert(false);
+        factor = 1U;
+    }
+
+    _decimation = factor;
+    _phase = 0;
+}
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+template<typename TimeType, typename ResultType>
+typename BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::size_type BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::convoluteDecimated(const Type* input, ResultType* output, size_type n, const TimeType& dt) {
+    size_type count{0};
+
+    convoluteChunks(input, n, [&](const size_type& i, const Type& position) {
+        const size_type remaining = _decimation - 1U - _phase; // samples after this one, until the next output
+        if(remaining < capacity() || remaining >= n - i) {     // or the next output is not in this call
+            DerivativeQueue::push(position);
+        }
+
+        if(remaining > 0) {
+            ++_phase;
+            return;
+        }
+
+        output[count++] = derivative_metrics.template operator()(DerivativeQueue::forwardConstIterator(),
+                                                                 DerivativeQueue::backwardConstIterator(),
+                                                                 dt);
+        _phase = 0;
+    });
+
+    return count;
+}
+
+template<typename Type, typename DerivativeMetrics, typename DerivativeQueue, typename Nested>
+void BasicShaperMetrics<Type, DerivativeMetrics, DerivativeQueue, Nested>::kernel(Type* output) const {
+    output[0] = Type(1);
+    Nested::convoluteKernel(output, 1U);
+}
+
+/**
+ * ShaperMetrics with given QueueType, for both of derivative queue and nested moving metrics.
+ */
+template<template<typename, size_t> class QueueType, typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+using QueuedShaperMetrics = BasicShaperMetrics<Type, DerivativeMetrics, QueueType<Type, Extent>, BasicMovingMetricsNested<QueueType, Type, MeanMetrics, Extents...>>;
+
+template<typename Type, typename DerivativeMetrics, size_t Extent, typename MeanMetrics, size_t... Extents>
+using ShaperMetrics = QueuedShaperMetrics<Queue, Type, DerivativeMetrics, Extent, MeanMetrics, Extents...>;
+}; // namespace ns
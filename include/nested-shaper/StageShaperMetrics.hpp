@@ -0,0 +1,147 @@
+/**
+ * @file StageShaperMetrics.hpp
+ *
+ * @brief This file contains the definition of the StageShaperMetrics class.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "FusedMovingMetrics.hpp"
+#include "tiny_utility.hpp" // for ns::array
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+/**
+ * @class StageShaperMetrics
+ *
+ * ShaperMetrics of euclidean samples, whose derivatives are built from differences of each stage,
+ * instead of finite differences of a queue of the last outputs.
+ * With the difference operator D = (1 - z^-1) / dt, a moving average of capacity c satisfies
+ * D SMA(u)[n] = (u[n] - u[n - c]) / (c dt), which is the pushed and popped samples of the stage.
+ * Applying it stage by stage from the last one, the k-th derivative of the output needs only the last k stages,
+ * and differences of the last k - 1 popped samples of each stage:
+ *
+ *   D^k y_s[n] = (D^(k-1) y_(s-1)[n] - D^(k-1) popped_s[n]) / (c_s dt)
+ *
+ * Results are exact in the sense of D, the same as the k-th backward difference of the output / dt^k,
+ * without the queue of derivatives and its N / 2 samples of delay, and without the table of coefficients.
+ * Position is the output of the last stage, and derivatives are available up to the number of stages.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam N Number of results, position and N - 1 derivatives, N - 1 should not exceed the number of stages.
+ * @tparam MeanMetrics Euclidean mean metrics functor of every stage.
+ * @tparam Extent, Extents Maximum extent of each stage.
+ */
+template<typename Type, size_t N, typename MeanMetrics, size_t Extent, size_t... Extents>
+class StageShaperMetrics : protected FusedMovingMetricsNested<Type, MeanMetrics, Extent, Extents...> {
+    using Nested = FusedMovingMetricsNested<Type, MeanMetrics, Extent, Extents...>;
+    static_assert(N > 0 && N <= 2U + sizeof...(Extents), "Number of derivatives should not exceed the number of stages.");
+
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    using Nested::stages;
+    using Nested::capacity;
+
+    /**
+     * Constructors
+     */
+    explicit StageShaperMetrics(const Type& value) :
+    Nested(value) { initializePopped(value); }
+    template<typename... Args>
+    explicit StageShaperMetrics(const Type& value, const Args&... capacities) :
+    Nested(value, capacities...) { initializePopped(value); }
+
+    /**
+     * (Re)Initializers
+     */
+    inline void initialize(const Type& value) {
+        Nested::initialize(value);
+        initializePopped(value);
+    }
+    template<typename... Args>
+    inline void initialize(const Type& value, const Args&... capacities) {
+        Nested::initialize(value, capacities...);
+        initializePopped(value);
+    }
+
+    /**
+     * Convolute
+     *
+     * derivatives[k] is the k-th derivative of the output at the last sample.
+     */
+    template<typename TimeType>
+    array<Type, N> convolute(const Type& input, const TimeType& dt);
+
+protected:
+    Type _popped[Nested::stages][N]{}; // _popped[s][i] : popped sample of stage s, i samples ago
+
+    inline void initializePopped(const Type& value) {
+        for(size_type s = 0; s < stages; ++s) {
+            for(size_type i = 0; i < N; ++i) {
+                _popped[s][i] = value;
+            }
+        }
+    }
+};
+
+template<typename Type, size_t N, typename MeanMetrics, size_t Extent, size_t... Extents>
+template<typename TimeType>
+array<Type, N> StageShaperMetrics<Type, N, MeanMetrics, Extent, Extents...>::convolute(const Type& input, const TimeType& dt) {
+    const Type reciprocal = Type(1) / Type(dt);
+
+    // k-th derivative of the output requires (k - 1 - stages after s)-th derivative of stage s,
+    // so stage s keeps order(s) popped samples, and computes derivatives up to order(s).
+    const auto order = [](const size_type& s) -> size_type { return N - 1U + s + 1U > stages ? N - 1U + s + 1U - stages : 0U; };
+
+    Type derivatives[N]; // derivatives of the input of stage s, then of its output
+    derivatives[0] = input;
+
+    Type* ring = Nested::_data;
+    for(size_type s = 0; s < stages; ++s) {
+        const size_type depth = order(s);
+        Type* const popped = _popped[s];
+        for(size_type i = depth; i-- > 1U;) {
+            popped[i] = popped[i - 1U];
+        }
+        if(depth > 0) {
+            popped[0] = ring[Nested::_backs[s]]; // the oldest sample, which is replaced by the input
+        }
+
+        const Type mean = Nested::convoluteStage(s, ring, derivatives[0]);
+        ring += Nested::extents[s];
+
+        // D^(k - 1) of popped samples, by backward differences of the history
+        Type differences[N];
+        for(size_type i = 0; i < depth; ++i) {
+            differences[i] = popped[i];
+        }
+
+        const Type scale = reciprocal / Type(capacity(s));
+        Type results[N];
+        for(size_type k = 1; k <= depth; ++k) {
+            results[k] = (derivatives[k - 1U] - differences[0]) * scale;
+            for(size_type i = 0; i + k < depth; ++i) {
+                differences[i] = (differences[i] - differences[i + 1U]) * reciprocal;
+            }
+        }
+
+        derivatives[0] = mean;
+        for(size_type k = 1; k <= depth; ++k) {
+            derivatives[k] = results[k];
+        }
+    }
+
+    array<Type, N> result{};
+    for(size_type k = 0; k < N; ++k) {
+        result[k] = derivatives[k];
+    }
+
+    return result;
+}
+
+}; // namespace ns
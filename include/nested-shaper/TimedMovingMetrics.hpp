@@ -0,0 +1,278 @@
+/**
+ * @file TimedMovingMetrics.hpp
+ *
+ * @brief This file contains the definition of the TimedMovingMetrics and TimedShaperMetrics classes.
+ *
+ * @author timetravelCat <timetraveler930@gmail.com>
+ */
+
+#pragma once
+
+#include "version.hpp"
+#include "Queue.hpp"
+#include "metrics/kahan_accumulator.hpp"
+#include "metrics/euclidean_derivative_non_uniform_metrics.hpp"
+#include <stddef.h>
+#include <assert.h>
+
+namespace ns {
+/**
+ * A sample with its time.
+ */
+template<typename Type, typename TimeType>
+struct TimedSample {
+    TimeType time;
+    Type value;
+};
+
+/**
+ * @class TimedMovingMetrics
+ *
+ * Moving average of timestamped samples over a window in time, instead of a number of samples.
+ * Input between samples is linear (or held from the previous sample, if ZeroOrderHold),
+ * and is integrated exactly over [time - window, time] by a compensated running integral.
+ * Samples may come with jitter and gaps, the queue keeps samples within the window and one before.
+ * If more than Extent samples fall within the window, the oldest segment is dropped and saturated() is set,
+ * then the mean is over the shortened window [oldest sample, time], until the window passes the oldest sample.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam TimeType Type of the time.
+ * @tparam Extent Maximum number of samples within a window.
+ * @tparam ZeroOrderHold Input is held between samples, instead of linear.
+ */
+template<typename Type, typename TimeType, size_t Extent, bool ZeroOrderHold = false>
+class TimedMovingMetrics : protected Queue<TimedSample<Type, TimeType>, Extent + 1U> {
+public:
+    using value_type = Type;
+    using time_type = TimeType;
+    using sample_type = TimedSample<Type, TimeType>;
+    using size_type = size_t;
+
+    /**
+     * Constructors
+     *
+     * The input was value until time.
+     */
+    explicit TimedMovingMetrics(const Type& value, const TimeType& time, const TimeType& window_) { initialize(value, time, window_); }
+
+    /**
+     * Status
+     */
+    inline TimeType window() const { return _window; }
+    using Queue<sample_type, Extent + 1U>::size;
+
+    /**
+     * The window has been shortened since initialize, as more than Extent samples fell within it.
+     */
+    inline bool saturated() const { return _saturated; }
+
+    /**
+     * (Re)Initializers
+     */
+    void initialize(const Type& value, const TimeType& time);
+    inline void initialize(const Type& value, const TimeType& time, const TimeType& window_) {
+        assert(window_ > TimeType(0));
+        _window = window_;
+        initialize(value, time);
+    }
+
+    /**
+     * Convolute
+     *
+     * value at time is convoluted, time should increase.
+     * returns the mean of the input over [time - window, time].
+     */
+    Type convolute(const TimeType& time, const Type& value);
+
+protected:
+    using Queue<sample_type, Extent + 1U>::back;
+    using Queue<sample_type, Extent + 1U>::front;
+
+    TimeType _window{TimeType(1)};
+    TimeType _start{TimeType(0)};               // start of the window
+    KahanBabushkaNeumaierSum<Type> _integral{}; // integral over the window
+    bool _saturated{false};                     // the window has been shortened since initialize
+
+    // Integral of the segment from a to b over [begin, end], within the segment
+    static inline Type integrate(const sample_type& a, const sample_type& b, const TimeType& begin, const TimeType& end) {
+        if(ZeroOrderHold || !(b.time > a.time)) {
+            return a.value * Type(end - begin);
+        }
+
+        const Type slope = (b.value - a.value) / Type(b.time - a.time);
+        const Type middle = a.value + slope * Type((begin + end) / TimeType(2) - a.time);
+        return middle * Type(end - begin);
+    }
+};
+
+template<typename Type, typename TimeType, size_t Extent, bool ZeroOrderHold>
+void TimedMovingMetrics<Type, TimeType, Extent, ZeroOrderHold>::initialize(const Type& value, const TimeType& time) {
+    Queue<sample_type, Extent + 1U>::reset();
+    Queue<sample_type, Extent + 1U>::push(sample_type{time - _window, value});
+    Queue<sample_type, Extent + 1U>::push(sample_type{time, value});
+    _start = time - _window;
+    _integral.reset(value * Type(_window));
+    _saturated = false;
+}
+
+template<typename Type, typename TimeType, size_t Extent, bool ZeroOrderHold>
+Type TimedMovingMetrics<Type, TimeType, Extent, ZeroOrderHold>::convolute(const TimeType& time, const Type& value) {
+    const sample_type sample{time, value};
+    if(!(time > front().time)) {
+        assert(false);
+        return _integral.sum() / Type(_window);
+    }
+
+    if(Queue<sample_type, Extent + 1U>::isFull()) {
+        // More than Extent samples within the window, the window is shortened to drop the oldest segment.
+        _saturated = true;
+        const sample_type oldest = back();
+        Queue<sample_type, Extent + 1U>::pop();
+        _integral.add(-integrate(oldest, back(), _start, back().time));
+        _start = back().time;
+    }
+
+    _integral.add(integrate(front(), sample, front().time, time));
+    Queue<sample_type, Extent + 1U>::push(sample);
+
+    // The window is still shortened, the mean is over [_start, time] instead of being extrapolated.
+    const TimeType start = time - _window;
+    if(!(start > _start)) {
+        return _integral.sum() / Type(time - _start);
+    }
+
+    // Remove the input, which is left out of the window.
+    while(!(back(1).time > start)) {
+        _integral.add(-integrate(back(), back(1), _start, back(1).time));
+        _start = back(1).time;
+        Queue<sample_type, Extent + 1U>::pop();
+    }
+
+    _integral.add(-integrate(back(), back(1), _start, start));
+    _start = start;
+
+    return _integral.sum() / Type(_window);
+}
+
+/**
+ * Nested TimedMovingMetrics, each stage has its own window in time.
+ * Input of the first stage may be held between samples, and is integrated exactly.
+ * Stages after the first assume outputs of the previous stage are linear between samples, which they are not in general
+ * (a moving average of linear segments is piecewise quadratic), so they are approximations, exact for linear inputs.
+ */
+template<typename Type, typename TimeType, bool ZeroOrderHold, size_t Extent, size_t... Extents>
+struct TimedMovingMetricsNested {
+    template<typename... Args>
+    explicit TimedMovingMetricsNested(const Type& value, const TimeType& time, const TimeType& window, const Args&... windows) :
+    moving_metrics(value, time, window), moving_metrics_nested(value, time, windows...) {
+        static_assert(sizeof...(windows) == sizeof...(Extents), "Number of windows must be equal to number of extents.");
+    }
+
+    inline void initialize(const Type& value, const TimeType& time) {
+        moving_metrics.initialize(value, time);
+        moving_metrics_nested.initialize(value, time);
+    }
+
+    inline Type convolute(const TimeType& time, const Type& value) {
+        return moving_metrics_nested.convolute(time, moving_metrics.convolute(time, value));
+    }
+
+    inline bool saturated() const {
+        return moving_metrics.saturated() || moving_metrics_nested.saturated();
+    }
+
+    TimedMovingMetrics<Type, TimeType, Extent, ZeroOrderHold> moving_metrics;
+    TimedMovingMetricsNested<Type, TimeType, false, Extents...> moving_metrics_nested;
+};
+
+template<typename Type, typename TimeType, bool ZeroOrderHold, size_t Extent>
+struct TimedMovingMetricsNested<Type, TimeType, ZeroOrderHold, Extent> {
+    explicit TimedMovingMetricsNested(const Type& value, const TimeType& time, const TimeType& window) :
+    moving_metrics(value, time, window) {}
+
+    inline void initialize(const Type& value, const TimeType& time) {
+        moving_metrics.initialize(value, time);
+    };
+
+    inline Type convolute(const TimeType& time, const Type& value) {
+        return moving_metrics.convolute(time, value);
+    };
+
+    inline bool saturated() const {
+        return moving_metrics.saturated();
+    };
+
+    TimedMovingMetrics<Type, TimeType, Extent, ZeroOrderHold> moving_metrics;
+};
+
+/**
+ * @class TimedShaperMetrics
+ *
+ * ShaperMetrics of timestamped samples, windows are given in time.
+ * Derivatives are finite differences of the last N outputs at their own times, by non-uniform weights.
+ * Like ShaperMetrics, results are at the time of the central sample of the last N outputs.
+ *
+ * @tparam Type Type of the elements.
+ * @tparam TimeType Type of the time.
+ * @tparam N Number of results, position and N - 1 derivatives.
+ * @tparam ZeroOrderHold Input is held between samples, instead of linear.
+ * @tparam Extent, Extents Maximum number of samples within the window of each stage.
+ */
+template<typename Type, typename TimeType, size_t N, bool ZeroOrderHold, size_t Extent, size_t... Extents>
+class TimedShaperMetrics : protected Queue<TimedSample<Type, TimeType>, N>, protected TimedMovingMetricsNested<Type, TimeType, ZeroOrderHold, Extent, Extents...> {
+    using Nested = TimedMovingMetricsNested<Type, TimeType, ZeroOrderHold, Extent, Extents...>;
+    using DerivativeQueue = Queue<TimedSample<Type, TimeType>, N>;
+
+public:
+    using value_type = Type;
+    using time_type = TimeType;
+    using size_type = size_t;
+
+    /**
+     * Constructors
+     *
+     * The input was value until time, windows of every stage are given in time.
+     */
+    template<typename... Args>
+    explicit TimedShaperMetrics(const Type& value, const TimeType& time, const Args&... windows) :
+    Nested(value, time, windows...) { initialize(value, time); }
+
+    /**
+     * (Re)Initializers
+     */
+    void initialize(const Type& value, const TimeType& time);
+
+    /**
+     * Any window has been shortened since initialize, as more samples than its extent fell within it.
+     */
+    using Nested::saturated;
+
+    /**
+     * Convolute
+     *
+     * value at time is convoluted, time should increase.
+     */
+    array<Type, N> convolute(const TimeType& time, const Type& value);
+
+protected:
+    EuclideanDerivativeNonUniformMetrics<Type, N> derivative_metrics{};
+};
+
+template<typename Type, typename TimeType, size_t N, bool ZeroOrderHold, size_t Extent, size_t... Extents>
+void TimedShaperMetrics<Type, TimeType, N, ZeroOrderHold, Extent, Extents...>::initialize(const Type& value, const TimeType& time) {
+    Nested::initialize(value, time);
+
+    // Distinct times are required by the weights, any step gives zero derivatives of a constant.
+    DerivativeQueue::reset();
+    for(size_type i = N; i-- > 0;) {
+        DerivativeQueue::push(TimedSample<Type, TimeType>{time - TimeType(i), value});
+    }
+}
+
+template<typename Type, typename TimeType, size_t N, bool ZeroOrderHold, size_t Extent, size_t... Extents>
+array<Type, N> TimedShaperMetrics<Type, TimeType, N, ZeroOrderHold, Extent, Extents...>::convolute(const TimeType& time, const Type& value) {
+    DerivativeQueue::push(TimedSample<Type, TimeType>{time, Nested::convolute(time, value)});
+    return derivative_metrics(DerivativeQueue::forwardConstIterator(), DerivativeQueue::backwardConstIterator());
+}
+
+}; // namespace ns
@@ -0,0 +1,81 @@
+/**
+ * @file angle_derivative_fixed_dt_metrics.hpp
+ *
+ * @brief This file contains the definition of the AngleDerivativeFixedDtMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+#include <nested-shaper/Queue.hpp>
+#include "angle_derivative_metrics.hpp"
+
+namespace ns {
+/**
+ * AngleDerivativeMetrics for a fixed dt, coefficients are divided by dt^k by the constructor or initialize(dt) as EuclideanDerivativeFixedDtMetrics.
+ * Angles are unwrapped, and the position wrapped, as AngleDerivativeMetrics does.
+ */
+template<typename Type, size_t N>
+struct AngleDerivativeFixedDtMetrics : protected AngleDerivativeMetrics<Type, N> {
+    static_assert(N > 1, "At least one derivative is required.");
+    using Base = AngleDerivativeMetrics<Type, N>;
+    using time_type = Type;
+
+    AngleDerivativeFixedDtMetrics() = default;
+    explicit AngleDerivativeFixedDtMetrics(const Type& dt) {
+        initialize(dt);
+    }
+
+    void initialize(const Type& dt) {
+        coefficients.scale(dt);
+    }
+
+    template<typename Iterator>
+    array<Type, N> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        assert(dt == coefficients.dt);
+        (void)backwardIterator;
+
+        return Base::template differentiateAngles<true>(forwardIterator, coefficients.value, dt);
+    }
+
+private:
+    SCALED_FINITE_DIFFERENCE_COEFFICIENTS<Type, N> coefficients{};
+};
+
+// M : dimension
+// N : derivative order
+// derivatives[i][j] : i-th dimension of j-th derivative
+template<typename Type, size_t M, size_t N>
+struct AngleDerivativeFixedDtMetricsArray : protected AngleDerivativeMetricsArray<Type, M, N> {
+    static_assert(N > 1, "At least one derivative is required.");
+    using Base = AngleDerivativeMetricsArray<Type, M, N>;
+    using array_type = typename Base::array_type;
+    using derivative_type = typename Base::derivative_type;
+    using time_type = Type;
+
+    AngleDerivativeFixedDtMetricsArray() = default;
+    explicit AngleDerivativeFixedDtMetricsArray(const Type& dt) {
+        initialize(dt);
+    }
+
+    void initialize(const Type& dt) {
+        coefficients.scale(dt);
+    }
+
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        assert(dt == coefficients.dt);
+        (void)backwardIterator;
+
+        return Base::template differentiateAngles<true>(forwardIterator, coefficients.value, dt);
+    }
+
+private:
+    SCALED_FINITE_DIFFERENCE_COEFFICIENTS<Type, N> coefficients{};
+};
+} // namespace ns
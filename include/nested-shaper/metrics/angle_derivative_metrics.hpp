@@ -11,48 +11,47 @@
 #include <math.h>
 #include <nested-shaper/tiny_utility.hpp> // for ns::array
 #include <nested-shaper/Queue.hpp>
-#include "central_finite_difference_coefficients.hpp"
+#include "euclidean_derivative_metrics.hpp"
 
 namespace ns {
+/**
+ * Position and N - 1 derivatives of the last N angles, by central finite differences.
+ * Each sample is unwrapped against the previous one, and the position is wrapped back to [-pi, pi).
+ */
 template<typename Type, size_t N>
-struct AngleDerivativeMetrics {
-    array<Type, N> operator()(QueueConstIterator<Type> forwardIterator, QueueConstIterator<Type> backwardIterator, const Type& dt) const {
+struct AngleDerivativeMetrics : protected EuclideanDerivativeMetrics<Type, N> {
+    using coefficients_type = typename EuclideanDerivativeMetrics<Type, N>::coefficients_type;
+
+    template<typename Iterator>
+    array<Type, N> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(N == forwardIterator.size);
         assert(N == backwardIterator.size);
         (void)backwardIterator;
 
+        static constexpr coefficients_type coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
+        return differentiateAngles<false>(forwardIterator, coefficients, dt);
+    }
+
+protected:
+    template<bool Prescaled, typename Iterator>
+    static array<Type, N> differentiateAngles(Iterator forwardIterator, const coefficients_type& coefficients, const Type& dt) {
         array<Type, N> angles_wrapped{};
         angles_wrapped[0] = *(forwardIterator++); // Assign first angle
 
         for(size_t i = 1U; i < N; i++) {
-            angles_wrapped[i] = wrap(*(forwardIterator++), angles_wrapped[i] - Type(M_PI), angles_wrapped[i] + Type(M_PI));
-        }
-
-        array<Type, N> derivatives{};
-        for(size_t i = 0; i < N; i++) {
-            derivatives[i] = Type(0);
-        }
-
-        derivatives[0] = angles_wrapped[N / 2U]; // Central point
-
-        Type dtn{dt};
-        static constexpr array<array<Type, N>, N - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
-        for(size_t i = 0; i < N - 1; i++) {
-            const size_t k = i + 1;
-            for(size_t j = 0; j < N; j++) {
-                derivatives[k] += coefficients[i][j] * angles_wrapped[j];
-            }
-            derivatives[k] /= dtn;
-            dtn *= dt;
+            angles_wrapped[i] = wrap(*(forwardIterator++), angles_wrapped[i - 1U] - Type(M_PI), angles_wrapped[i - 1U] + Type(M_PI));
         }
 
+        array<Type, N> derivatives = EuclideanDerivativeMetrics<Type, N>::template differentiate<Prescaled>(angles_wrapped, coefficients, dt);
+        derivatives[0] = wrap(derivatives[0], Type(-M_PI), Type(M_PI)); // Central point, unwrapped samples may leave [-pi, pi)
         return derivatives;
     }
 };
 
 template<typename Type>
 struct AngleDerivativeMetrics<Type, 1> {
-    array<Type, 1> operator()(QueueConstIterator<Type> forwardIterator, QueueConstIterator<Type> backwardIterator, const Type& dt) const {
+    template<typename Iterator>
+    array<Type, 1> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(1 == forwardIterator.size);
         assert(1 == backwardIterator.size);
         (void)backwardIterator;
@@ -65,53 +64,61 @@ struct AngleDerivativeMetrics<Type, 1> {
 // N : derivative order
 // derivatives[i][j] : i-th dimension of j-th derivative
 template<typename Type, size_t M, size_t N>
-struct AngleDerivativeMetricsArray {
+struct AngleDerivativeMetricsArray : protected EuclideanDerivativeMetricsArray<Type, M, N> {
     using array_type = array<Type, M>;
     using derivative_type = array<array<Type, N>, M>;
+    using coefficients_type = typename EuclideanDerivativeMetricsArray<Type, M, N>::coefficients_type;
 
-    derivative_type operator()(QueueConstIterator<array_type> forwardIterator, QueueConstIterator<array_type> backwardIterator, const Type& dt) const {
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(N == forwardIterator.size);
         assert(N == backwardIterator.size);
         (void)backwardIterator;
 
+        static constexpr coefficients_type coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
+        return differentiateAngles<false>(forwardIterator, coefficients, dt);
+    }
+
+protected:
+    template<bool Prescaled, typename Iterator>
+    static derivative_type differentiateAngles(const Iterator& forwardIterator, const coefficients_type& coefficients, const Type& dt) {
         Type angles_wrapped[N][M];
+        unwrap(forwardIterator, angles_wrapped, 0);
+
+        derivative_type derivatives = EuclideanDerivativeMetricsArray<Type, M, N>::template differentiateWindow<Prescaled>(angles_wrapped, coefficients, dt);
         for(size_t i = 0; i < M; i++) {
-            angles_wrapped[0][i] = (*forwardIterator)[i]; // Assign first angle
+            derivatives[i][0] = wrap(derivatives[i][0], Type(-M_PI), Type(M_PI)); // Central point, unwrapped samples may leave [-pi, pi)
         }
-        ++forwardIterator;
 
-        for(size_t i = 1U; i < N; i++) {
-            for(size_t j = 0; j < M; j++) {
-                angles_wrapped[i][j] = wrap((*forwardIterator)[j], angles_wrapped[i - 1U][j] - Type(M_PI), angles_wrapped[i - 1U][j] + Type(M_PI));
-            }
-            ++forwardIterator;
-        }
+        return derivatives;
+    }
 
-        derivative_type derivatives{};
-        for(size_t i = 0; i < M; i++) {
-            for(size_t j = 0; j < N; j++) {
-                derivatives[i][j] = Type(0);
+    // Structure-of-arrays window, if the iterator provides lane(m)
+    template<typename Iterator>
+    static auto unwrap(const Iterator& forwardIterator, Type (&angles_wrapped)[N][M], int) -> decltype(forwardIterator.lane(0), void()) {
+        for(size_t j = 0; j < M; j++) {
+            const auto lane = forwardIterator.lane(j);
+
+            angles_wrapped[0][j] = lane[0]; // Assign first angle
+            for(size_t i = 1U; i < N; i++) {
+                angles_wrapped[i][j] = wrap(lane[i], angles_wrapped[i - 1U][j] - Type(M_PI), angles_wrapped[i - 1U][j] + Type(M_PI));
             }
         }
+    }
 
+    template<typename Iterator>
+    static void unwrap(Iterator forwardIterator, Type (&angles_wrapped)[N][M], long) {
         for(size_t i = 0; i < M; i++) {
-            derivatives[i][0] = angles_wrapped[N / 2U][i]; // Central point
+            angles_wrapped[0][i] = (*forwardIterator)[i]; // Assign first angle
         }
+        ++forwardIterator;
 
-        static constexpr array<array<Type, N>, N - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
-        for(size_t m = 0; m < M; m++) {
-            Type dtn{dt};
-            for(size_t i = 0; i < N - 1; i++) {
-                const size_t k = i + 1;
-                for(size_t j = 0; j < N; j++) {
-                    derivatives[m][k] += coefficients[i][j] * angles_wrapped[j][m];
-                }
-                derivatives[m][k] /= dtn;
-                dtn *= dt;
+        for(size_t i = 1U; i < N; i++) {
+            for(size_t j = 0; j < M; j++) {
+                angles_wrapped[i][j] = wrap((*forwardIterator)[j], angles_wrapped[i - 1U][j] - Type(M_PI), angles_wrapped[i - 1U][j] + Type(M_PI));
             }
+            ++forwardIterator;
         }
-
-        return derivatives;
     }
 };
 
@@ -120,7 +127,8 @@ struct AngleDerivativeMetricsArray<Type, M, 1> {
     using array_type = array<Type, M>;
     using derivative_type = array<array<Type, 1>, M>;
 
-   derivative_type operator()(QueueConstIterator<array_type> forwardIterator, QueueConstIterator<array_type> backwardIterator, const Type& dt) const {
+    template<typename Iterator>
+   derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(1 == forwardIterator.size);
         assert(1 == backwardIterator.size);
         (void)backwardIterator;
@@ -16,11 +16,12 @@ namespace ns {
 // https://en.wikipedia.org/wiki/Circular_mean
 template<typename Type>
 struct AngleMeanCumulativeMetrics {
+    template<typename Iterator>
     Type operator()(const Type& mean,
                     const Type& popped,
                     const Type& pushed,
-                    QueueConstIterator<Type> forwardIterator,
-                    QueueConstIterator<Type> backwardIterator) const {
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) const {
         (void)mean;
         (void)popped;
         (void)pushed;
@@ -28,13 +29,29 @@ struct AngleMeanCumulativeMetrics {
 
         Type s{Type(0)};
         Type c{Type(0)};
+        accumulate(forwardIterator, s, c, 0);
 
+        return ::atan2(s, c);
+    }
+
+private:
+    // Contiguous window, if the iterator provides span()
+    template<typename Iterator>
+    static auto accumulate(const Iterator& forwardIterator, Type& s, Type& c, int) -> decltype(forwardIterator.span(), void()) {
+        const auto window = forwardIterator.span();
+
+        for(size_t i = 0; i < window.size; ++i) {
+            s += ::sin(window[i]);
+            c += ::cos(window[i]);
+        }
+    }
+
+    template<typename Iterator>
+    static void accumulate(Iterator forwardIterator, Type& s, Type& c, long) {
         for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
             s += ::sin(*forwardIterator);
             c += ::cos(*forwardIterator);
         }
-
-        return ::atan2(s, c);
     }
 };
 
@@ -42,12 +59,13 @@ template<typename Type, size_t N>
 struct AngleMeanCumulativeMetricsArray {
     using array_type = ns::array<Type, N>;
 
+    template<typename Iterator>
     array_type operator()(
       const array_type& mean,
       const array_type& popped,
       const array_type& pushed,
-      QueueConstIterator<array_type> forwardIterator,
-      QueueConstIterator<array_type> backwardIterator) const {
+      Iterator forwardIterator,
+      Iterator backwardIterator) const {
         (void)mean;
         (void)popped;
         (void)pushed;
@@ -60,12 +78,7 @@ struct AngleMeanCumulativeMetricsArray {
             c[i] = Type(0);
         }
 
-        for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
-            for(size_t j = 0; j < N; ++j) {
-                s[j] += ::sin((*forwardIterator)[j]);
-                c[j] += ::cos((*forwardIterator)[j]);
-            }
-        }
+        accumulate(forwardIterator, s, c, 0);
 
         array_type means{};
         for(size_t i = 0; i < N; ++i) {
@@ -74,6 +87,43 @@ struct AngleMeanCumulativeMetricsArray {
 
         return means;
     }
+
+private:
+    // Structure-of-arrays window, if the iterator provides lane(m)
+    template<typename Iterator>
+    static auto accumulate(const Iterator& forwardIterator, array_type& s, array_type& c, int) -> decltype(forwardIterator.lane(0), void()) {
+        for(size_t j = 0; j < N; ++j) {
+            const auto lane = forwardIterator.lane(j);
+
+            for(size_t i = 0; i < lane.size; ++i) {
+                s[j] += ::sin(lane[i]);
+                c[j] += ::cos(lane[i]);
+            }
+        }
+    }
+
+    // Contiguous window, if the iterator provides span()
+    template<typename Iterator>
+    static auto accumulate(const Iterator& forwardIterator, array_type& s, array_type& c, int) -> decltype(forwardIterator.span(), void()) {
+        const auto window = forwardIterator.span();
+
+        for(size_t i = 0; i < window.size; ++i) {
+            for(size_t j = 0; j < N; ++j) {
+                s[j] += ::sin(window[i][j]);
+                c[j] += ::cos(window[i][j]);
+            }
+        }
+    }
+
+    template<typename Iterator>
+    static void accumulate(Iterator forwardIterator, array_type& s, array_type& c, long) {
+        for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
+            for(size_t j = 0; j < N; ++j) {
+                s[j] += ::sin((*forwardIterator)[j]);
+                c[j] += ::cos((*forwardIterator)[j]);
+            }
+        }
+    }
 };
 
 }; // namespace ns
\ No newline at end of file
@@ -14,11 +14,12 @@
 namespace ns {
 template<typename Type>
 struct AngleMeanRecursiveMetrics {
+    template<typename Iterator>
     Type operator()(const Type& mean,
                     const Type& popped,
                     const Type& pushed,
-                    QueueConstIterator<Type> forwardIterator,
-                    QueueConstIterator<Type> backwardIterator) {
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) {
         (void)forwardIterator;
         (void)backwardIterator;
 
@@ -34,12 +35,13 @@ template<typename Type, size_t N>
 struct AngleMeanRecursiveMetricsArray {
     using array_type = ns::array<Type, N>;
 
+    template<typename Iterator>
     array_type operator()(
       const array_type& mean,
       const array_type& popped,
       const array_type& pushed,
-      QueueConstIterator<array_type> forwardIterator,
-      QueueConstIterator<array_type> backwardIterator) {
+      Iterator forwardIterator,
+      Iterator backwardIterator) {
         (void)forwardIterator;
         (void)backwardIterator;
 
@@ -0,0 +1,104 @@
+/**
+ * @file angle_mean_running_sum_metrics.hpp
+ * 
+ * @brief This file contains the definition of the AngleMeanRunningSumMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "kahan_accumulator.hpp"
+#include <nested-shaper/Queue.hpp>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array, ns::wrap
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+namespace ns {
+/**
+ * Keeps a running sum of angles in [-bound, bound), bound is pi * window size.
+ * A whole turn of every angle in the window is 2 * bound, which is added exactly by the compensated sum.
+ */
+template<typename Type>
+inline void wrap_running_sum(KahanBabushkaNeumaierSum<Type>& sum, const Type& bound) {
+    if(sum.sum() >= bound) {
+        sum.add(Type(-2) * bound);
+    } else if(sum.sum() < -bound) {
+        sum.add(Type(2) * bound);
+    }
+}
+
+/**
+ * Recursive angle mean by a compensated running sum of the window.
+ * The difference of pushed and popped is wrapped to [-pi, pi), so the sum follows angles across the wrap, as long as the window spans less than pi.
+ * The sum is kept in [-pi, pi) * window size by adding multiples of 2pi * window size, so it stays bounded over unbounded runtimes,
+ * and the mean is wrapped to [-pi, pi) like the other angle metrics.
+ * The sum is scaled by the reciprocal of the window size, cached at initialize, so there is no division per sample.
+ */
+template<typename Type>
+struct AngleMeanRunningSumMetrics {
+    void initialize(const Type& value, const size_t& capacity) {
+        sum.reset(wrap(value, Type(-M_PI), Type(M_PI)) * Type(capacity));
+        reciprocal = Type(1) / Type(capacity);
+        bound = Type(M_PI) * Type(capacity);
+    }
+
+    template<typename Iterator>
+    Type operator()(const Type& mean,
+                    const Type& popped,
+                    const Type& pushed,
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) {
+        (void)mean;
+        (void)forwardIterator;
+        (void)backwardIterator;
+
+        sum.add(wrap(pushed - popped, Type(-M_PI), Type(M_PI)));
+        wrap_running_sum(sum, bound);
+        return wrap(sum.sum() * reciprocal, Type(-M_PI), Type(M_PI));
+    }
+
+private:
+    KahanBabushkaNeumaierSum<Type> sum{};
+    Type reciprocal{Type(1)}; // 1 / window size
+    Type bound{Type(M_PI)};   // pi * window size
+};
+
+template<typename Type, size_t N>
+struct AngleMeanRunningSumMetricsArray {
+    using array_type = ns::array<Type, N>;
+
+    void initialize(const array_type& value, const size_t& capacity) {
+        for(size_t i = 0; i < N; ++i) {
+            sums[i].reset(wrap(value[i], Type(-M_PI), Type(M_PI)) * Type(capacity));
+        }
+        reciprocal = Type(1) / Type(capacity);
+        bound = Type(M_PI) * Type(capacity);
+    }
+
+    template<typename Iterator>
+    array_type operator()(
+      const array_type& mean,
+      const array_type& popped,
+      const array_type& pushed,
+      Iterator forwardIterator,
+      Iterator backwardIterator) {
+        (void)mean;
+        (void)forwardIterator;
+        (void)backwardIterator;
+
+        array_type means{};
+        for(size_t i = 0; i < N; ++i) {
+            sums[i].add(wrap(pushed[i] - popped[i], Type(-M_PI), Type(M_PI)));
+            wrap_running_sum(sums[i], bound);
+            means[i] = wrap(sums[i].sum() * reciprocal, Type(-M_PI), Type(M_PI));
+        }
+
+        return means;
+    }
+
+private:
+    KahanBabushkaNeumaierSum<Type> sums[N]{};
+    Type reciprocal{Type(1)}; // 1 / window size
+    Type bound{Type(M_PI)};   // pi * window size
+};
+} // namespace ns
@@ -0,0 +1,97 @@
+/**
+ * @file backward_finite_difference_coefficients.hpp
+ * 
+ * @brief This file contains the definition of the BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS function.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+
+namespace ns {
+/**
+ * N : Number of elements in the queue, from the oldest to the latest sample.
+ * value[k - 1] : coefficients of the k-th derivative at the latest sample, exact for polynomials of degree less than N.
+ * https://en.wikipedia.org/wiki/Finite_difference_coefficient
+ */
+template<typename T, size_t N>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS {
+    static_assert((N <= 9), "Not implemented");
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 2> {
+    static constexpr array<array<T, 2>, 1> value{
+      array<T, 2>{T(-1.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 3> {
+    static constexpr array<array<T, 3>, 2> value{
+      array<T, 3>{T(1.0 / 2.0), T(-4.0 / 2.0), T(3.0 / 2.0)},
+      array<T, 3>{T(1.0), T(-2.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 4> {
+    static constexpr array<array<T, 4>, 3> value{
+      array<T, 4>{T(-2.0 / 6.0), T(9.0 / 6.0), T(-18.0 / 6.0), T(11.0 / 6.0)},
+      array<T, 4>{T(-1.0), T(4.0), T(-5.0), T(2.0)},
+      array<T, 4>{T(-1.0), T(3.0), T(-3.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 5> {
+    static constexpr array<array<T, 5>, 4> value{
+      array<T, 5>{T(3.0 / 12.0), T(-16.0 / 12.0), T(36.0 / 12.0), T(-48.0 / 12.0), T(25.0 / 12.0)},
+      array<T, 5>{T(11.0 / 12.0), T(-56.0 / 12.0), T(114.0 / 12.0), T(-104.0 / 12.0), T(35.0 / 12.0)},
+      array<T, 5>{T(3.0 / 2.0), T(-14.0 / 2.0), T(24.0 / 2.0), T(-18.0 / 2.0), T(5.0 / 2.0)},
+      array<T, 5>{T(1.0), T(-4.0), T(6.0), T(-4.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 6> {
+    static constexpr array<array<T, 6>, 5> value{
+      array<T, 6>{T(-12.0 / 60.0), T(75.0 / 60.0), T(-200.0 / 60.0), T(300.0 / 60.0), T(-300.0 / 60.0), T(137.0 / 60.0)},
+      array<T, 6>{T(-10.0 / 12.0), T(61.0 / 12.0), T(-156.0 / 12.0), T(214.0 / 12.0), T(-154.0 / 12.0), T(45.0 / 12.0)},
+      array<T, 6>{T(-7.0 / 4.0), T(41.0 / 4.0), T(-98.0 / 4.0), T(118.0 / 4.0), T(-71.0 / 4.0), T(17.0 / 4.0)},
+      array<T, 6>{T(-2.0), T(11.0), T(-24.0), T(26.0), T(-14.0), T(3.0)},
+      array<T, 6>{T(-1.0), T(5.0), T(-10.0), T(10.0), T(-5.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 7> {
+    static constexpr array<array<T, 7>, 6> value{
+      array<T, 7>{T(10.0 / 60.0), T(-72.0 / 60.0), T(225.0 / 60.0), T(-400.0 / 60.0), T(450.0 / 60.0), T(-360.0 / 60.0), T(147.0 / 60.0)},
+      array<T, 7>{T(137.0 / 180.0), T(-972.0 / 180.0), T(2970.0 / 180.0), T(-5080.0 / 180.0), T(5265.0 / 180.0), T(-3132.0 / 180.0), T(812.0 / 180.0)},
+      array<T, 7>{T(15.0 / 8.0), T(-104.0 / 8.0), T(307.0 / 8.0), T(-496.0 / 8.0), T(461.0 / 8.0), T(-232.0 / 8.0), T(49.0 / 8.0)},
+      array<T, 7>{T(17.0 / 6.0), T(-114.0 / 6.0), T(321.0 / 6.0), T(-484.0 / 6.0), T(411.0 / 6.0), T(-186.0 / 6.0), T(35.0 / 6.0)},
+      array<T, 7>{T(5.0 / 2.0), T(-32.0 / 2.0), T(85.0 / 2.0), T(-120.0 / 2.0), T(95.0 / 2.0), T(-40.0 / 2.0), T(7.0 / 2.0)},
+      array<T, 7>{T(1.0), T(-6.0), T(15.0), T(-20.0), T(15.0), T(-6.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 8> {
+    static constexpr array<array<T, 8>, 7> value{
+      array<T, 8>{T(-60.0 / 420.0), T(490.0 / 420.0), T(-1764.0 / 420.0), T(3675.0 / 420.0), T(-4900.0 / 420.0), T(4410.0 / 420.0), T(-2940.0 / 420.0), T(1089.0 / 420.0)},
+      array<T, 8>{T(-126.0 / 180.0), T(1019.0 / 180.0), T(-3618.0 / 180.0), T(7380.0 / 180.0), T(-9490.0 / 180.0), T(7911.0 / 180.0), T(-4014.0 / 180.0), T(938.0 / 180.0)},
+      array<T, 8>{T(-232.0 / 120.0), T(1849.0 / 120.0), T(-6432.0 / 120.0), T(12725.0 / 120.0), T(-15560.0 / 120.0), T(11787.0 / 120.0), T(-5104.0 / 120.0), T(967.0 / 120.0)},
+      array<T, 8>{T(-21.0 / 6.0), T(164.0 / 6.0), T(-555.0 / 6.0), T(1056.0 / 6.0), T(-1219.0 / 6.0), T(852.0 / 6.0), T(-333.0 / 6.0), T(56.0 / 6.0)},
+      array<T, 8>{T(-25.0 / 6.0), T(190.0 / 6.0), T(-621.0 / 6.0), T(1130.0 / 6.0), T(-1235.0 / 6.0), T(810.0 / 6.0), T(-295.0 / 6.0), T(46.0 / 6.0)},
+      array<T, 8>{T(-3.0), T(22.0), T(-69.0), T(120.0), T(-125.0), T(78.0), T(-27.0), T(4.0)},
+      array<T, 8>{T(-1.0), T(7.0), T(-21.0), T(35.0), T(-35.0), T(21.0), T(-7.0), T(1.0)}};
+};
+
+template<typename T>
+struct BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<T, 9> {
+    static constexpr array<array<T, 9>, 8> value{
+      array<T, 9>{T(105.0 / 840.0), T(-960.0 / 840.0), T(3920.0 / 840.0), T(-9408.0 / 840.0), T(14700.0 / 840.0), T(-15680.0 / 840.0), T(11760.0 / 840.0), T(-6720.0 / 840.0), T(2283.0 / 840.0)},
+      array<T, 9>{T(3267.0 / 5040.0), T(-29664.0 / 5040.0), T(120008.0 / 5040.0), T(-284256.0 / 5040.0), T(435330.0 / 5040.0), T(-448672.0 / 5040.0), T(312984.0 / 5040.0), T(-138528.0 / 5040.0), T(29531.0 / 5040.0)},
+      array<T, 9>{T(469.0 / 240.0), T(-4216.0 / 240.0), T(16830.0 / 240.0), T(-39128.0 / 240.0), T(58280.0 / 240.0), T(-57384.0 / 240.0), T(36706.0 / 240.0), T(-13960.0 / 240.0), T(2403.0 / 240.0)},
+      array<T, 9>{T(967.0 / 240.0), T(-8576.0 / 240.0), T(33636.0 / 240.0), T(-76352.0 / 240.0), T(109930.0 / 240.0), T(-102912.0 / 240.0), T(61156.0 / 240.0), T(-21056.0 / 240.0), T(3207.0 / 240.0)},
+      array<T, 9>{T(35.0 / 6.0), T(-305.0 / 6.0), T(1170.0 / 6.0), T(-2581.0 / 6.0), T(3580.0 / 6.0), T(-3195.0 / 6.0), T(1790.0 / 6.0), T(-575.0 / 6.0), T(81.0 / 6.0)},
+      array<T, 9>{T(23.0 / 4.0), T(-196.0 / 4.0), T(732.0 / 4.0), T(-1564.0 / 4.0), T(2090.0 / 4.0), T(-1788.0 / 4.0), T(956.0 / 4.0), T(-292.0 / 4.0), T(39.0 / 4.0)},
+      array<T, 9>{T(7.0 / 2.0), T(-58.0 / 2.0), T(210.0 / 2.0), T(-434.0 / 2.0), T(560.0 / 2.0), T(-462.0 / 2.0), T(238.0 / 2.0), T(-70.0 / 2.0), T(9.0 / 2.0)},
+      array<T, 9>{T(1.0), T(-8.0), T(28.0), T(-56.0), T(70.0), T(-56.0), T(28.0), T(-8.0), T(1.0)}};
+};
+}; // namespace ns
@@ -94,4 +94,47 @@ struct CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<T, 9> {
       array<T, 9>{T(-1.0 / 2.0), T(6.0 / 2.0), T(-14.0 / 2.0), T(14.0 / 2.0), T(0.0 / 2.0), T(-14.0 / 2.0), T(14.0 / 2.0), T(-6.0 / 2.0), T(1.0 / 2.0)},
       array<T, 9>{T(1.0), T(-8.0), T(28.0), T(-56.0), T(70.0), T(-56.0), T(28.0), T(-8.0), T(1.0)}};
 };
-}; // namespace ns
\ No newline at end of file
+
+/**
+ * Coefficients scaled by 2^FractionBits and rounded to nearest integers, for fixed-point derivatives.
+ */
+template<typename T, size_t N, size_t FractionBits>
+constexpr array<array<T, N>, N - 1> fixed_point_coefficients() {
+    array<array<T, N>, N - 1> result{};
+    for(size_t i = 0; i < N - 1; i++) {
+        for(size_t j = 0; j < N; j++) {
+            const double scaled = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<double, N>::value.data[i].data[j] * double(1ULL << FractionBits);
+            result.data[i].data[j] = static_cast<T>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+        }
+    }
+
+    return result;
+};
+
+template<typename T, size_t N, size_t FractionBits>
+struct CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS_FIXED_POINT {
+    static constexpr array<array<T, N>, N - 1> value = fixed_point_coefficients<T, N, FractionBits>();
+};
+
+/**
+ * Coefficients divided by dt^k, for a fixed time step.
+ * value[k - 1][j] : weight of j-th sample for k-th derivative, derivatives are sums of weighted samples without division.
+ */
+template<typename T, size_t N, typename Coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<T, N>>
+struct SCALED_FINITE_DIFFERENCE_COEFFICIENTS {
+    array<array<T, N>, N - 1> value{};
+    T dt{T(0)};
+
+    void scale(const T& dt_) {
+        dt = dt_;
+        T dtn{dt_};
+        static constexpr array<array<T, N>, N - 1> coefficients = Coefficients::value;
+        for(size_t i = 0; i < N - 1; i++) {
+            for(size_t j = 0; j < N; j++) {
+                value[i][j] = coefficients[i][j] / dtn;
+            }
+            dtn *= dt_;
+        }
+    }
+};
+}; // namespace ns
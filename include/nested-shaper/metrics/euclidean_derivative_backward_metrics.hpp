@@ -0,0 +1,28 @@
+/**
+ * @file euclidean_derivative_backward_metrics.hpp
+ *
+ * @brief This file contains the definition of the EuclideanDerivativeBackwardMetrics alias.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+#include <nested-shaper/Queue.hpp>
+#include "backward_finite_difference_coefficients.hpp"
+#include "euclidean_derivative_metrics.hpp"
+
+namespace ns {
+/**
+ * One-sided version of EuclideanDerivativeMetrics, the output point is the latest sample instead of the central one.
+ * Results do not lag N / 2 samples, but backward differences are less accurate and more sensitive to noise.
+ */
+template<typename Type, size_t N>
+using EuclideanDerivativeBackwardMetrics = EuclideanDerivativeMetrics<Type, N, BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>, N - 1U>;
+
+// M : dimension
+// N : derivative order
+// derivatives[i][j] : i-th dimension of j-th derivative
+template<typename Type, size_t M, size_t N>
+using EuclideanDerivativeBackwardMetricsArray = EuclideanDerivativeMetricsArray<Type, M, N, BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>, N - 1U>;
+}; // namespace ns
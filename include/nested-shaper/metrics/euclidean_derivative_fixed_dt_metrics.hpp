@@ -0,0 +1,83 @@
+/**
+ * @file euclidean_derivative_fixed_dt_metrics.hpp
+ *
+ * @brief This file contains the definition of the EuclideanDerivativeFixedDtMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+#include <nested-shaper/Queue.hpp>
+#include "euclidean_derivative_metrics.hpp"
+
+namespace ns {
+/**
+ * EuclideanDerivativeMetrics for a fixed dt.
+ * Coefficients are divided by dt^k once, by the constructor or initialize(dt), so each derivative is a sum of weighted samples, without division.
+ * Default constructed metrics are not scaled until initialize(dt), and dt given to operator() must be the one given to initialize.
+ * FixedDtShaperMetrics takes dt with the value of the shaper, so it can not be missed.
+ */
+template<typename Type, size_t N, typename Coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>, size_t Point = N / 2U>
+struct EuclideanDerivativeFixedDtMetrics : protected EuclideanDerivativeMetrics<Type, N, Coefficients, Point> {
+    static_assert(N > 1, "At least one derivative is required.");
+    using Base = EuclideanDerivativeMetrics<Type, N, Coefficients, Point>;
+    using time_type = Type;
+
+    EuclideanDerivativeFixedDtMetrics() = default;
+    explicit EuclideanDerivativeFixedDtMetrics(const Type& dt) {
+        initialize(dt);
+    }
+
+    void initialize(const Type& dt) {
+        coefficients.scale(dt);
+    }
+
+    template<typename Iterator>
+    array<Type, N> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        assert(dt == coefficients.dt);
+        (void)backwardIterator;
+
+        return Base::template differentiate<true>(Base::window(forwardIterator, 0), coefficients.value, dt);
+    }
+
+private:
+    SCALED_FINITE_DIFFERENCE_COEFFICIENTS<Type, N, Coefficients> coefficients{};
+};
+
+// M : dimension
+// N : derivative order
+// derivatives[i][j] : i-th dimension of j-th derivative
+template<typename Type, size_t M, size_t N, typename Coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>, size_t Point = N / 2U>
+struct EuclideanDerivativeFixedDtMetricsArray : protected EuclideanDerivativeMetricsArray<Type, M, N, Coefficients, Point> {
+    static_assert(N > 1, "At least one derivative is required.");
+    using Base = EuclideanDerivativeMetricsArray<Type, M, N, Coefficients, Point>;
+    using array_type = typename Base::array_type;
+    using derivative_type = typename Base::derivative_type;
+    using time_type = Type;
+
+    EuclideanDerivativeFixedDtMetricsArray() = default;
+    explicit EuclideanDerivativeFixedDtMetricsArray(const Type& dt) {
+        initialize(dt);
+    }
+
+    void initialize(const Type& dt) {
+        coefficients.scale(dt);
+    }
+
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        assert(dt == coefficients.dt);
+        (void)backwardIterator;
+
+        return Base::template differentiate<true>(forwardIterator, coefficients.value, dt, 0);
+    }
+
+private:
+    SCALED_FINITE_DIFFERENCE_COEFFICIENTS<Type, N, Coefficients> coefficients{};
+};
+}; // namespace ns
@@ -0,0 +1,108 @@
+/**
+ * @file euclidean_derivative_fixed_point_metrics.hpp
+ * 
+ * @brief This file contains the definition of the EuclideanDerivativeFixedPointMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array, ns::divide_rounded
+#include <nested-shaper/Queue.hpp>
+#include "central_finite_difference_coefficients.hpp"
+
+namespace ns {
+/**
+ * Derivatives of integer (or fixed-point) samples, without floating point.
+ * Finite difference coefficients are scaled by 2^FractionBits and rounded to integers.
+ * Each derivative is a single integer division of the weighted sum by (dt^k * 2^FractionBits), rounded to nearest.
+ * 
+ * dt is an integer time step (e.g. 1 for derivatives per sample period).
+ * SumType holds the scaled coefficients, the weighted sums and the divisors, so both
+ * |sample| * (sum of |coefficients|) * 2^FractionBits and dt^(N - 1) * 2^FractionBits should fit in it.
+ * With the defaults (int64_t, 16 bits) and N <= 5, |sample| < 2^43 and dt^(N - 1) < 2^46 are safe.
+ */
+template<typename Type, size_t N, size_t FractionBits = 16, typename SumType = int64_t>
+struct EuclideanDerivativeFixedPointMetrics {
+    template<typename Iterator>
+    array<Type, N> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        (void)backwardIterator;
+
+        array<Type, N> samples{};
+        for(size_t j = 0; j < N; j++, ++forwardIterator) {
+            samples[j] = *forwardIterator;
+        }
+
+        return differentiate(samples, dt);
+    }
+
+    static array<Type, N> differentiate(const array<Type, N>& samples, const Type& dt) {
+        array<Type, N> derivatives{};
+        derivatives[0] = samples[N / 2U]; // Central point
+
+        SumType scale{SumType(dt) * (SumType(1) << FractionBits)};
+        static constexpr array<array<SumType, N>, N - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS_FIXED_POINT<SumType, N, FractionBits>::value;
+        for(size_t i = 0; i < N - 1; i++) {
+            SumType sum{0};
+            for(size_t j = 0; j < N; j++) {
+                sum += coefficients[i][j] * SumType(samples[j]);
+            }
+            derivatives[i + 1] = Type(divide_rounded(sum, scale));
+            scale *= SumType(dt);
+        }
+
+        return derivatives;
+    }
+};
+
+template<typename Type, size_t FractionBits, typename SumType>
+struct EuclideanDerivativeFixedPointMetrics<Type, 1, FractionBits, SumType> {
+    template<typename Iterator>
+    array<Type, 1> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(1 == forwardIterator.size);
+        assert(1 == backwardIterator.size);
+        (void)backwardIterator;
+        (void)dt;
+        return array<Type, 1>{*forwardIterator};
+    }
+
+    static array<Type, 1> differentiate(const array<Type, 1>& samples, const Type& dt) {
+        (void)dt;
+        return samples;
+    }
+};
+
+// M : dimension
+// N : derivative order
+// derivatives[i][j] : i-th dimension of j-th derivative
+template<typename Type, size_t M, size_t N, size_t FractionBits = 16, typename SumType = int64_t>
+struct EuclideanDerivativeFixedPointMetricsArray {
+    using array_type = array<Type, M>;
+    using derivative_type = array<array<Type, N>, M>;
+
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        (void)backwardIterator;
+
+        array<array<Type, N>, M> samples{};
+        for(size_t j = 0; j < N; j++, ++forwardIterator) {
+            const array_type sample = *forwardIterator;
+            for(size_t m = 0; m < M; m++) {
+                samples[m][j] = sample[m];
+            }
+        }
+
+        derivative_type derivatives{};
+        for(size_t m = 0; m < M; m++) {
+            derivatives[m] = EuclideanDerivativeFixedPointMetrics<Type, N, FractionBits, SumType>::differentiate(samples[m], dt);
+        }
+
+        return derivatives;
+    }
+};
+}; // namespace ns
@@ -12,39 +12,88 @@
 #include "central_finite_difference_coefficients.hpp"
 
 namespace ns {
+template<typename Type, size_t M, size_t N, typename Coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>, size_t Point = N / 2U>
+struct EuclideanDerivativeMetricsArray;
 
-template<typename Type, size_t N>
+/**
+ * Position and N - 1 derivatives of the last N samples, by finite differences.
+ * Coefficients is a table of coefficients, value[k - 1][j] is the weight of the j-th sample (from the oldest) for the k-th derivative,
+ * and the results are at the Point-th sample, e.g. N / 2 for central differences and N - 1 for backward differences.
+ */
+template<typename Type, size_t N, typename Coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>, size_t Point = N / 2U>
 struct EuclideanDerivativeMetrics {
-    array<Type, N> operator()(QueueConstIterator<Type> forwardIterator, QueueConstIterator<Type> backwardIterator, const Type& dt) const {
+    static_assert(Point < N, "Point must be one of N samples.");
+    using coefficients_type = array<array<Type, N>, N - 1>;
+
+    template<typename Iterator>
+    array<Type, N> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(N == forwardIterator.size);
         assert(N == backwardIterator.size);
         (void)backwardIterator;
 
+        static constexpr coefficients_type coefficients = Coefficients::value;
+        return differentiate<false>(window(forwardIterator, 0), coefficients, dt);
+    }
+
+protected:
+    template<typename _Type, size_t _M, size_t _N, typename _Coefficients, size_t _Point>
+    friend struct EuclideanDerivativeMetricsArray;
+
+    // Contiguous window, if the iterator provides span()
+    template<typename Iterator>
+    static auto window(const Iterator& forwardIterator, int) -> decltype(forwardIterator.span()) {
+        return forwardIterator.span();
+    }
+
+    template<typename Iterator>
+    static array<Type, N> window(Iterator forwardIterator, long) {
+        array<Type, N> samples{};
+        for(size_t j = 0; j < N; j++, ++forwardIterator) {
+            samples[j] = *forwardIterator;
+        }
+
+        return samples;
+    }
+
+    // Weighted sums of samples by coefficients[k - 1], divided by dt^k unless coefficients are Prescaled by dt^k.
+    template<bool Prescaled, typename Window>
+    static array<Type, N> differentiate(const Window& samples, const coefficients_type& coefficients, const Type& dt) {
         array<Type, N> derivatives{};
         for(size_t i = 0; i < N; i++) {
             derivatives[i] = Type(0);
         }
 
-        derivatives[0] = *(forwardIterator + (N / 2U)); // Central point
+        derivatives[0] = samples[Point];
 
         Type dtn{dt};
-        static constexpr array<array<Type, N>, N - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
         for(size_t i = 0; i < N - 1; i++) {
             const size_t k = i + 1;
-            for(size_t j = 0; j < N; j++) {
-                derivatives[k] += coefficients[i][j] * (*(forwardIterator + j));
+            derivatives[k] = weigh(samples, coefficients[i]);
+            if(!Prescaled) {
+                derivatives[k] /= dtn;
+                dtn *= dt;
             }
-            derivatives[k] /= dtn;
-            dtn *= dt;
         }
 
         return derivatives;
     }
+
+    // Sum of samples[j] * weights[j], a row of coefficients
+    template<typename Window>
+    static Type weigh(const Window& samples, const array<Type, N>& weights) {
+        Type sum{Type(0)};
+        for(size_t j = 0; j < N; j++) {
+            sum += weights[j] * samples[j];
+        }
+
+        return sum;
+    }
 };
 
-template<typename Type>
-struct EuclideanDerivativeMetrics<Type, 1> {
-    array<Type, 1> operator()(QueueConstIterator<Type> forwardIterator, QueueConstIterator<Type> backwardIterator, const Type& dt) const {
+template<typename Type, typename Coefficients, size_t Point>
+struct EuclideanDerivativeMetrics<Type, 1, Coefficients, Point> {
+    template<typename Iterator>
+    array<Type, 1> operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(1 == forwardIterator.size);
         assert(1 == backwardIterator.size);
         (void)backwardIterator;
@@ -56,16 +105,59 @@ struct EuclideanDerivativeMetrics<Type, 1> {
 // M : dimension
 // N : derivative order
 // derivatives[i][j] : i-th dimension of j-th derivative
-template<typename Type, size_t M, size_t N>
+template<typename Type, size_t M, size_t N, typename Coefficients, size_t Point>
 struct EuclideanDerivativeMetricsArray {
+    static_assert(Point < N, "Point must be one of N samples.");
     using array_type = array<Type, M>;
     using derivative_type = array<array<Type, N>, M>;
+    using coefficients_type = array<array<Type, N>, N - 1>;
 
-    derivative_type operator()(QueueConstIterator<array_type> forwardIterator, QueueConstIterator<array_type> backwardIterator, const Type& dt) const {
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(N == forwardIterator.size);
         assert(N == backwardIterator.size);
         (void)backwardIterator;
 
+        static constexpr coefficients_type coefficients = Coefficients::value;
+        return differentiate<false>(forwardIterator, coefficients, dt, 0);
+    }
+
+protected:
+    // Structure-of-arrays window, if the iterator provides lane(m)
+    template<bool Prescaled, typename Iterator>
+    static auto differentiate(const Iterator& forwardIterator, const coefficients_type& coefficients, const Type& dt, int) -> decltype(forwardIterator.lane(0), derivative_type()) {
+        derivative_type derivatives{};
+        for(size_t m = 0; m < M; m++) {
+            derivatives[m] = EuclideanDerivativeMetrics<Type, N, Coefficients, Point>::template differentiate<Prescaled>(forwardIterator.lane(m), coefficients, dt);
+        }
+
+        return derivatives;
+    }
+
+    template<bool Prescaled, typename Iterator>
+    static derivative_type differentiate(const Iterator& forwardIterator, const coefficients_type& coefficients, const Type& dt, long) {
+        return differentiateWindow<Prescaled>(window(forwardIterator, 0), coefficients, dt);
+    }
+
+    // Contiguous window, if the iterator provides span()
+    template<typename Iterator>
+    static auto window(const Iterator& forwardIterator, int) -> decltype(forwardIterator.span()) {
+        return forwardIterator.span();
+    }
+
+    template<typename Iterator>
+    static array<array_type, N> window(Iterator forwardIterator, long) {
+        array<array_type, N> samples{};
+        for(size_t j = 0; j < N; j++, ++forwardIterator) {
+            samples[j] = *forwardIterator;
+        }
+
+        return samples;
+    }
+
+    // Weighted sums of samples[j][m] by coefficients[k - 1], divided by dt^k unless coefficients are Prescaled by dt^k.
+    template<bool Prescaled, typename Window>
+    static derivative_type differentiateWindow(const Window& samples, const coefficients_type& coefficients, const Type& dt) {
         derivative_type derivatives{};
         for(size_t i = 0; i < M; i++) {
             for(size_t j = 0; j < N; j++) {
@@ -74,19 +166,20 @@ struct EuclideanDerivativeMetricsArray {
         }
 
         for(size_t i = 0; i < M; i++) {
-            derivatives[i][0] = (*(forwardIterator + (N / 2U)))[i]; // Central point
+            derivatives[i][0] = samples[Point][i];
         }
 
-        static constexpr array<array<Type, N>, N - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
         for(size_t m = 0; m < M; m++) {
             Type dtn{dt};
             for(size_t i = 0; i < N - 1; i++) {
                 const size_t k = i + 1;
                 for(size_t j = 0; j < N; j++) {
-                    derivatives[m][k] += coefficients[i][j] * (*(forwardIterator + j))[m];
+                    derivatives[m][k] += coefficients[i][j] * samples[j][m];
+                }
+                if(!Prescaled) {
+                    derivatives[m][k] /= dtn;
+                    dtn *= dt;
                 }
-                derivatives[m][k] /= dtn;
-                dtn *= dt;
             }
         }
 
@@ -94,12 +187,13 @@ struct EuclideanDerivativeMetricsArray {
     }
 };
 
-template<typename Type, size_t M>
-struct EuclideanDerivativeMetricsArray<Type, M, 1> {
+template<typename Type, size_t M, typename Coefficients, size_t Point>
+struct EuclideanDerivativeMetricsArray<Type, M, 1, Coefficients, Point> {
     using array_type = array<Type, M>;
     using derivative_type = array<array<Type, 1>, M>;
 
-    derivative_type operator()(QueueConstIterator<array_type> forwardIterator, QueueConstIterator<array_type> backwardIterator, const Type& dt) const {
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
         assert(1 == forwardIterator.size);
         assert(1 == backwardIterator.size);
         (void)backwardIterator;
@@ -0,0 +1,95 @@
+/**
+ * @file euclidean_derivative_non_uniform_metrics.hpp
+ *
+ * @brief This file contains the definition of the EuclideanDerivativeNonUniformMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <assert.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+
+namespace ns {
+/**
+ * Finite differences of N samples at non-uniform times, by weights of Fornberg's algorithm.
+ * Iterators dereference to timed samples, which provide time and value.
+ * Derivatives are evaluated at the time of the central sample, same as EuclideanDerivativeMetrics on a uniform grid.
+ */
+template<typename Type, size_t N>
+struct EuclideanDerivativeNonUniformMetrics {
+    template<typename Iterator>
+    array<Type, N> operator()(Iterator forwardIterator, Iterator backwardIterator) const {
+        assert(N == forwardIterator.size);
+        (void)backwardIterator;
+
+        using time_type = decltype((*forwardIterator).time);
+        time_type times[N];
+        Type values[N];
+        for(size_t j = 0; j < N; j++, ++forwardIterator) {
+            times[j] = (*forwardIterator).time;
+            values[j] = (*forwardIterator).value;
+        }
+
+        // Times relative to the central sample
+        const time_type center = times[N / 2U];
+        for(size_t j = 0; j < N; j++) {
+            times[j] -= center;
+        }
+
+        time_type weights[N][N];
+        fornberg(times, weights);
+
+        array<Type, N> derivatives{};
+        derivatives[0] = values[N / 2U]; // Central point
+        for(size_t k = 1; k < N; k++) {
+            derivatives[k] = Type(0);
+            for(size_t j = 0; j < N; j++) {
+                derivatives[k] += Type(weights[j][k]) * values[j];
+            }
+        }
+
+        return derivatives;
+    }
+
+    /**
+     * weights[j][k] : weight of j-th sample for k-th derivative at time 0, exact for polynomials of degree less than N.
+     */
+    template<typename TimeType>
+    static void fornberg(const TimeType (&times)[N], TimeType (&weights)[N][N]) {
+        for(size_t j = 0; j < N; j++) {
+            for(size_t k = 0; k < N; k++) {
+                weights[j][k] = TimeType(0);
+            }
+        }
+
+        TimeType c1{1};
+        TimeType c4{times[0]};
+        weights[0][0] = TimeType(1);
+        for(size_t i = 1; i < N; i++) {
+            TimeType c2{1};
+            const TimeType c5{c4};
+            c4 = times[i];
+
+            for(size_t j = 0; j < i; j++) {
+                const TimeType c3 = times[i] - times[j];
+                c2 *= c3;
+
+                if(j == i - 1U) {
+                    for(size_t k = i; k > 0; k--) {
+                        weights[i][k] = c1 * (TimeType(k) * weights[i - 1U][k - 1U] - c5 * weights[i - 1U][k]) / c2;
+                    }
+                    weights[i][0] = -c1 * c5 * weights[i - 1U][0] / c2;
+                }
+
+                for(size_t k = i; k > 0; k--) {
+                    weights[j][k] = (c4 * weights[j][k] - TimeType(k) * weights[j][k - 1U]) / c3;
+                }
+                weights[j][0] = c4 * weights[j][0] / c3;
+            }
+
+            c1 = c2;
+        }
+    }
+};
+} // namespace ns
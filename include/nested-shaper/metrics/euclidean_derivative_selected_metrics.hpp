@@ -0,0 +1,104 @@
+/**
+ * @file euclidean_derivative_selected_metrics.hpp
+ *
+ * @brief This file contains the definition of the EuclideanDerivativeSelectedMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+#include <nested-shaper/Queue.hpp>
+#include "central_finite_difference_coefficients.hpp"
+#include "euclidean_derivative_metrics.hpp"
+
+namespace ns {
+/**
+ * Compile-time set of derivative orders, 0 is position.
+ */
+template<size_t... Orders>
+struct derivative_orders {
+    static constexpr size_t size = sizeof...(Orders);
+    static constexpr size_t value[size] = {Orders...};
+
+    // Every order is less than n
+    static constexpr bool less_than(const size_t n) {
+        for(size_t i = 0; i < size; i++) {
+            if(value[i] >= n) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // No order is selected twice
+    static constexpr bool unique() {
+        for(size_t i = 0; i < size; i++) {
+            for(size_t j = i + 1U; j < size; j++) {
+                if(value[i] == value[j]) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+};
+
+template<size_t... Orders>
+constexpr size_t derivative_orders<Orders...>::size;
+template<size_t... Orders>
+constexpr size_t derivative_orders<Orders...>::value[derivative_orders<Orders...>::size];
+
+/**
+ * EuclideanDerivativeMetrics of N samples, which computes and returns only the selected orders.
+ * derivatives[i] is the Orders[i]-th derivative, same as derivatives[Orders[i]] of EuclideanDerivativeMetrics.
+ * e.g. EuclideanDerivativeSelectedMetrics<float, 5, derivative_orders<0, 2>> for position and acceleration.
+ * Results are not a Taylor series unless Orders are 0, 1, 2 ..., so evaluate of ShaperMetrics is not meaningful otherwise.
+ * Every order should be less than N, and selected once. Samples are read as a contiguous range, if the queue provides span().
+ */
+template<typename Type, size_t N, typename Orders>
+struct EuclideanDerivativeSelectedMetrics;
+
+template<typename Type, size_t N, size_t... Orders>
+struct EuclideanDerivativeSelectedMetrics<Type, N, derivative_orders<Orders...>> : protected EuclideanDerivativeMetrics<Type, N> {
+    using orders_type = derivative_orders<Orders...>;
+    using derivative_type = array<Type, sizeof...(Orders)>;
+    static_assert(sizeof...(Orders) > 0, "At least one order must be selected.");
+    static_assert(orders_type::less_than(N), "Orders must be less than N.");
+    static_assert(orders_type::unique(), "Orders must be unique.");
+
+    template<typename Iterator>
+    derivative_type operator()(Iterator forwardIterator, Iterator backwardIterator, const Type& dt) const {
+        assert(N == forwardIterator.size);
+        assert(N == backwardIterator.size);
+        (void)backwardIterator;
+
+        const auto samples = EuclideanDerivativeMetrics<Type, N>::window(forwardIterator, 0);
+
+        derivative_type derivatives{};
+        for(size_t i = 0; i < sizeof...(Orders); i++) {
+            derivatives[i] = derivative(samples, orders_type::value[i], dt);
+        }
+
+        return derivatives;
+    }
+
+private:
+    template<typename Window>
+    static Type derivative(const Window& samples, const size_t& order, const Type& dt) {
+        if(order == 0) {
+            return samples[N / 2U]; // Central point
+        }
+
+        Type dtn{dt};
+        for(size_t k = 1; k < order; k++) {
+            dtn *= dt;
+        }
+
+        static constexpr array<array<Type, N>, N - 1> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS<Type, N>::value;
+        return EuclideanDerivativeMetrics<Type, N>::weigh(samples, coefficients[order - 1U]) / dtn;
+    }
+};
+} // namespace ns
@@ -13,22 +13,80 @@
 namespace ns {
 template<typename Type>
 struct EuclideanMeanCumulativeMetrics {
+    template<typename Iterator>
     Type operator()(const Type& mean,
                     const Type& popped,
                     const Type& pushed,
-                    QueueConstIterator<Type> forwardIterator,
-                    QueueConstIterator<Type> backwardIterator) const {
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) const {
         (void)mean;
         (void)popped;
         (void)pushed;
         (void)backwardIterator;
 
+        return accumulate(forwardIterator, 0) / static_cast<Type>(forwardIterator.size);
+    }
+
+    // Block kernel of MovingMetrics, windows of eight consecutive samples are summed together.
+    // Each sum is in the same order as operator(), but the eight chains of additions are independent.
+    Type block(const Type& mean, const Type* history, Type* output, const size_t& n, const size_t& capacity) const {
+        const Type size = static_cast<Type>(capacity);
+
+        size_t i = 0;
+        for(; i + 8U <= n; i += 8U) {
+            const Type* window = history + i + 1U;
+            Type sums[8]{Type(0), Type(0), Type(0), Type(0), Type(0), Type(0), Type(0), Type(0)};
+            for(size_t j = 0; j < capacity; ++j) {
+                sums[0] += window[j];
+                sums[1] += window[j + 1U];
+                sums[2] += window[j + 2U];
+                sums[3] += window[j + 3U];
+                sums[4] += window[j + 4U];
+                sums[5] += window[j + 5U];
+                sums[6] += window[j + 6U];
+                sums[7] += window[j + 7U];
+            }
+
+            for(size_t k = 0; k < 8U; ++k) {
+                output[i + k] = sums[k] / size;
+            }
+        }
+
+        for(; i < n; ++i) {
+            const Type* window = history + i + 1U;
+            Type sum{Type(0)};
+            for(size_t j = 0; j < capacity; ++j) {
+                sum += window[j];
+            }
+
+            output[i] = sum / size;
+        }
+
+        return n > 0 ? output[n - 1U] : mean;
+    }
+
+private:
+    // Contiguous window, if the iterator provides span()
+    template<typename Iterator>
+    static auto accumulate(const Iterator& forwardIterator, int) -> decltype(forwardIterator.span(), Type()) {
+        const auto window = forwardIterator.span();
+
+        Type sum{Type(0)};
+        for(size_t i = 0; i < window.size; ++i) {
+            sum += window[i];
+        }
+
+        return sum;
+    }
+
+    template<typename Iterator>
+    static Type accumulate(Iterator forwardIterator, long) {
         Type sum{Type(0)};
         for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
             sum += *forwardIterator;
         }
 
-        return sum / static_cast<Type>(forwardIterator.size);
+        return sum;
     }
 };
 
@@ -36,30 +94,74 @@ template<typename Type, size_t N>
 struct EuclideanMeanCumulativeMetricsArray {
     using array_type = ns::array<Type, N>;
 
+    template<typename Iterator>
     array_type operator()(
       const array_type& mean,
       const array_type& popped,
       const array_type& pushed,
-      QueueConstIterator<array_type> forwardIterator,
-      QueueConstIterator<array_type> backwardIterator) const {
+      Iterator forwardIterator,
+      Iterator backwardIterator) const {
         (void)mean;
         (void)popped;
         (void)pushed;
         (void)backwardIterator;
 
+        array_type sums = accumulate(forwardIterator, 0);
+        for(size_t j = 0; j < N; ++j) {
+            sums[j] /= static_cast<Type>(forwardIterator.size);
+        }
+
+        return sums;
+    }
+
+private:
+    // Structure-of-arrays window, if the iterator provides lane(m)
+    template<typename Iterator>
+    static auto accumulate(const Iterator& forwardIterator, int) -> decltype(forwardIterator.lane(0), array_type()) {
+        array_type sums{};
+        for(size_t j = 0; j < N; ++j) {
+            const auto lane = forwardIterator.lane(j);
+
+            Type sum{Type(0)};
+            for(size_t i = 0; i < lane.size; ++i) {
+                sum += lane[i];
+            }
+            sums[j] = sum;
+        }
+
+        return sums;
+    }
+
+    // Contiguous window, if the iterator provides span()
+    template<typename Iterator>
+    static auto accumulate(const Iterator& forwardIterator, int) -> decltype(forwardIterator.span(), array_type()) {
+        const auto window = forwardIterator.span();
+
         array_type sums{};
         for(size_t j = 0; j < N; ++j) {
             sums[j] = Type(0);
         }
 
-        for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
+        for(size_t i = 0; i < window.size; ++i) {
             for(size_t j = 0; j < N; ++j) {
-                sums[j] += (*forwardIterator)[j];
+                sums[j] += window[i][j];
             }
         }
 
+        return sums;
+    }
+
+    template<typename Iterator>
+    static array_type accumulate(Iterator forwardIterator, long) {
+        array_type sums{};
         for(size_t j = 0; j < N; ++j) {
-            sums[j] /= static_cast<Type>(forwardIterator.size);
+            sums[j] = Type(0);
+        }
+
+        for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
+            for(size_t j = 0; j < N; ++j) {
+                sums[j] += (*forwardIterator)[j];
+            }
         }
 
         return sums;
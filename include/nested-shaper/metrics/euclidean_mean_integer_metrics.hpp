@@ -0,0 +1,77 @@
+/**
+ * @file euclidean_mean_integer_metrics.hpp
+ * 
+ * @brief This file contains the definition of the EuclideanMeanIntegerMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <nested-shaper/Queue.hpp>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array, ns::divide_rounded
+
+namespace ns {
+/**
+ * Exact mean of integer (or fixed-point) samples.
+ * The running sum of the window is updated by integers only, so it never drifts.
+ * The mean is the sum divided by the window size, rounded to nearest.
+ * 
+ * SumType should hold capacity times the largest sample, e.g. int64_t for int32_t samples.
+ */
+template<typename Type, typename SumType = int64_t>
+struct EuclideanMeanIntegerMetrics {
+    void initialize(const Type& value, const size_t& capacity) {
+        sum = SumType(value) * SumType(capacity);
+    }
+
+    template<typename Iterator>
+    Type operator()(const Type& mean,
+                    const Type& popped,
+                    const Type& pushed,
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) {
+        (void)mean;
+        (void)backwardIterator;
+
+        sum += SumType(pushed) - SumType(popped);
+        return Type(divide_rounded(sum, SumType(forwardIterator.size)));
+    }
+
+private:
+    SumType sum{0}; // Sum of the window
+};
+
+template<typename Type, size_t N, typename SumType = int64_t>
+struct EuclideanMeanIntegerMetricsArray {
+    using array_type = ns::array<Type, N>;
+
+    void initialize(const array_type& value, const size_t& capacity) {
+        for(size_t i = 0; i < N; ++i) {
+            sums[i] = SumType(value[i]) * SumType(capacity);
+        }
+    }
+
+    template<typename Iterator>
+    array_type operator()(
+      const array_type& mean,
+      const array_type& popped,
+      const array_type& pushed,
+      Iterator forwardIterator,
+      Iterator backwardIterator) {
+        (void)mean;
+        (void)backwardIterator;
+
+        array_type means{};
+        for(size_t i = 0; i < N; ++i) {
+            sums[i] += SumType(pushed[i]) - SumType(popped[i]);
+            means[i] = Type(divide_rounded(sums[i], SumType(forwardIterator.size)));
+        }
+
+        return means;
+    }
+
+private:
+    SumType sums[N]{}; // Sum of the window, for each dimension
+};
+} // namespace ns
@@ -0,0 +1,114 @@
+/**
+ * @file euclidean_mean_resync_metrics.hpp
+ * 
+ * @brief This file contains the definition of the EuclideanMeanResyncMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "kahan_accumulator.hpp"
+#include <nested-shaper/Queue.hpp>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+
+namespace ns {
+/**
+ * Recursive mean, which is resynchronized with the exact sum of the window every window size.
+ * Every pushed sample is also added to a shadow sum, which is started empty.
+ * After window size samples the shadow sum holds exactly the samples of the window, and replaces the running sum.
+ * Therefore the cost per sample is O(1), and the error is bounded by rounding of a single window forever.
+ */
+template<typename Type>
+struct EuclideanMeanResyncMetrics {
+    void initialize(const Type& value, const size_t& capacity_) {
+        sum = value * Type(capacity_);
+        shadow.reset(Type(0));
+        reciprocal = Type(1) / Type(capacity_);
+        capacity = capacity_;
+        count = 0;
+    }
+
+    template<typename Iterator>
+    Type operator()(const Type& mean,
+                    const Type& popped,
+                    const Type& pushed,
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) {
+        (void)mean;
+        (void)forwardIterator;
+        (void)backwardIterator;
+
+        sum += pushed - popped;
+        shadow.add(pushed);
+
+        if(++count == capacity) {
+            sum = shadow.sum();
+            shadow.reset(Type(0));
+            count = 0;
+        }
+
+        return sum * reciprocal;
+    }
+
+private:
+    Type sum{Type(0)};                       // running sum of the window
+    KahanBabushkaNeumaierSum<Type> shadow{}; // sum of samples pushed since the last resynchronization
+    Type reciprocal{Type(1)};                // 1 / window size
+    size_t capacity{1};                      // window size
+    size_t count{0};                         // number of samples in shadow
+};
+
+template<typename Type, size_t N>
+struct EuclideanMeanResyncMetricsArray {
+    using array_type = ns::array<Type, N>;
+
+    void initialize(const array_type& value, const size_t& capacity_) {
+        for(size_t i = 0; i < N; ++i) {
+            sums[i] = value[i] * Type(capacity_);
+            shadows[i].reset(Type(0));
+        }
+        reciprocal = Type(1) / Type(capacity_);
+        capacity = capacity_;
+        count = 0;
+    }
+
+    template<typename Iterator>
+    array_type operator()(
+      const array_type& mean,
+      const array_type& popped,
+      const array_type& pushed,
+      Iterator forwardIterator,
+      Iterator backwardIterator) {
+        (void)mean;
+        (void)forwardIterator;
+        (void)backwardIterator;
+
+        const bool resync = ++count == capacity;
+        if(resync) {
+            count = 0;
+        }
+
+        array_type means{};
+        for(size_t i = 0; i < N; ++i) {
+            sums[i] += pushed[i] - popped[i];
+            shadows[i].add(pushed[i]);
+
+            if(resync) {
+                sums[i] = shadows[i].sum();
+                shadows[i].reset(Type(0));
+            }
+
+            means[i] = sums[i] * reciprocal;
+        }
+
+        return means;
+    }
+
+private:
+    Type sums[N]{};                             // running sums of the window
+    KahanBabushkaNeumaierSum<Type> shadows[N]{}; // sums of samples pushed since the last resynchronization
+    Type reciprocal{Type(1)};                   // 1 / window size
+    size_t capacity{1};                         // window size
+    size_t count{0};                            // number of samples in shadows
+};
+} // namespace ns
@@ -0,0 +1,80 @@
+/**
+ * @file euclidean_mean_running_sum_metrics.hpp
+ * 
+ * @brief This file contains the definition of the EuclideanMeanRunningSumMetrics class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "kahan_accumulator.hpp"
+#include <nested-shaper/Queue.hpp>
+#include <nested-shaper/tiny_utility.hpp> // for ns::array
+
+namespace ns {
+/**
+ * Recursive mean by a compensated running sum of the window.
+ * The sum is scaled by the reciprocal of the window size, cached at initialize, so there is no division per sample.
+ */
+template<typename Type>
+struct EuclideanMeanRunningSumMetrics {
+    void initialize(const Type& value, const size_t& capacity) {
+        sum.reset(value * Type(capacity));
+        reciprocal = Type(1) / Type(capacity);
+    }
+
+    template<typename Iterator>
+    Type operator()(const Type& mean,
+                    const Type& popped,
+                    const Type& pushed,
+                    Iterator forwardIterator,
+                    Iterator backwardIterator) {
+        (void)mean;
+        (void)forwardIterator;
+        (void)backwardIterator;
+
+        sum.add(pushed - popped);
+        return sum.sum() * reciprocal;
+    }
+
+private:
+    KahanBabushkaNeumaierSum<Type> sum{};
+    Type reciprocal{Type(1)}; // 1 / window size
+};
+
+template<typename Type, size_t N>
+struct EuclideanMeanRunningSumMetricsArray {
+    using array_type = ns::array<Type, N>;
+
+    void initialize(const array_type& value, const size_t& capacity) {
+        for(size_t i = 0; i < N; ++i) {
+            sums[i].reset(value[i] * Type(capacity));
+        }
+        reciprocal = Type(1) / Type(capacity);
+    }
+
+    template<typename Iterator>
+    array_type operator()(
+      const array_type& mean,
+      const array_type& popped,
+      const array_type& pushed,
+      Iterator forwardIterator,
+      Iterator backwardIterator) {
+        (void)mean;
+        (void)forwardIterator;
+        (void)backwardIterator;
+
+        array_type means{};
+        for(size_t i = 0; i < N; ++i) {
+            sums[i].add(pushed[i] - popped[i]);
+            means[i] = sums[i].sum() * reciprocal;
+        }
+
+        return means;
+    }
+
+private:
+    KahanBabushkaNeumaierSum<Type> sums[N]{};
+    Type reciprocal{Type(1)}; // 1 / window size
+};
+} // namespace ns
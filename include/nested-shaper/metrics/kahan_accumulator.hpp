@@ -21,4 +21,28 @@ class KahanBabushkaNeumaierAccumulator {
 private:
     Type c{Type(0)}; // A running compensation for lost low-order bits.
 };
-} // namespace ns
+
+/**
+ * Compensated running sum, the compensation is kept apart from the sum.
+ */
+template<typename Type>
+class KahanBabushkaNeumaierSum {
+public:
+    void reset(const Type& value) {
+        s = value;
+        c = Type(0);
+    }
+
+    void add(const Type& value) {
+        const Type t = s + value;
+        c += ::fabs(s) >= ::fabs(value) ? (s - t) + value : (value - t) + s;
+        s = t;
+    }
+
+    Type sum() const { return s + c; }
+
+private:
+    Type s{Type(0)}; // Running sum
+    Type c{Type(0)}; // A running compensation for lost low-order bits.
+};
+} // namespace ns
\ No newline at end of file
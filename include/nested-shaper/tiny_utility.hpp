@@ -8,6 +8,20 @@
 
 #include <stddef.h>
 #include <math.h>
+#include <string.h>
+
+#ifndef NESTED_SHAPER_CACHE_LINE_SIZE
+#define NESTED_SHAPER_CACHE_LINE_SIZE 64
+#endif
+
+// Pointers, which do not alias each other within their scope.
+#ifndef NESTED_SHAPER_RESTRICT
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define NESTED_SHAPER_RESTRICT __restrict
+#else
+#define NESTED_SHAPER_RESTRICT
+#endif
+#endif
 
 namespace ns {
 /**
@@ -77,6 +91,37 @@ struct array {
     };
 };
 
+/**
+ * @class span
+ * 
+ * Non-owning view of contiguous elements.
+ */
+template<typename T>
+struct span {
+    /**
+     * Members
+     */
+    T* data;
+    size_t size;
+
+    /**
+     * Subscript operator
+     */
+    T& operator[](size_t i) const {
+        return data[i];
+    };
+
+    /**
+     * Range
+     */
+    T* begin() const {
+        return data;
+    };
+    T* end() const {
+        return data + size;
+    };
+};
+
 /**
  * @fn wrap
  * 
@@ -92,4 +137,110 @@ T wrap(const T& value, const T& low, const T& high) {
     const T num_wraps = ::floor((value - low) / range);
     return value - num_wraps * range;
 };
+
+/**
+ * @fn copy_n
+ * 
+ * @brief Copy n elements from src to dst, which should not overlap. (memcpy-style)
+ */
+template<typename T>
+void copy_n(const T* src, size_t n, T* dst) {
+    for(size_t i = 0; i < n; ++i) {
+        dst[i] = src[i];
+    }
+};
+
+/**
+ * @fn next_power_of_two
+ * 
+ * @brief Smallest power of two, greater than or equal to the value.
+ */
+constexpr size_t next_power_of_two(const size_t value) {
+    size_t result = 1U;
+    while(result < value) {
+        result <<= 1U;
+    }
+
+    return result;
+};
+
+/**
+ * @fn divide_rounded
+ * 
+ * @brief Integer division rounded to nearest, half away from zero. denominator should be positive.
+ */
+template<typename T>
+constexpr T divide_rounded(const T& numerator, const T& denominator) {
+    return (numerator < T(0) ? numerator - denominator / T(2) : numerator + denominator / T(2)) / denominator;
+};
+
+/**
+ * @fn sum_of
+ * 
+ * @brief Sum of the given values, usable in constant expressions.
+ */
+constexpr size_t sum_of() {
+    return 0U;
+};
+template<typename... Args>
+constexpr size_t sum_of(const size_t value, const Args... values) {
+    return value + sum_of(values...);
+};
+
+/**
+ * @fn taylor_shift
+ * 
+ * @brief Position and derivatives at h, from position and derivatives at 0, as the polynomial of degree N - 1.
+ * Nested arrays are derivatives of each dimension, derivatives[i][j] : i-th dimension of j-th derivative.
+ */
+template<typename T, size_t N, typename H>
+array<T, N> taylor_shift(const array<T, N>& derivatives, const H& h) {
+    const T step = T(h);
+    array<T, N> result{};
+    for(size_t k = 0; k < N; ++k) {
+        // sum of derivatives[j] h^(j - k) / (j - k)!, by Horner
+        T value = derivatives[N - 1U];
+        for(size_t j = N - 1U; j > k; --j) {
+            value = value * step / T(j - k) + derivatives[j - 1U];
+        }
+        result[k] = value;
+    }
+
+    return result;
+};
+template<typename T, size_t N, size_t M, typename H>
+array<array<T, N>, M> taylor_shift(const array<array<T, N>, M>& derivatives, const H& h) {
+    array<array<T, N>, M> result{};
+    for(size_t i = 0; i < M; ++i) {
+        result[i] = taylor_shift(derivatives[i], h);
+    }
+
+    return result;
+};
+
+/**
+ * @class state_block
+ * 
+ * Raw bytes of a trivially copyable object, saved and restored by a single memcpy.
+ */
+template<typename T>
+struct state_block {
+    alignas(T) unsigned char bytes[sizeof(T)];
+};
+
+/**
+ * @fn save_state, load_state
+ * 
+ * @brief Copy the whole object into the state block, and back.
+ */
+template<typename T>
+void save_state(const T& object, state_block<T>& state) {
+    static_assert(__is_trivially_copyable(T), "State of the object must be trivially copyable.");
+    ::memcpy(state.bytes, &object, sizeof(T));
+};
+template<typename T>
+void load_state(T& object, const state_block<T>& state) {
+    static_assert(__is_trivially_copyable(T), "State of the object must be trivially copyable.");
+    ::memcpy(&object, state.bytes, sizeof(T));
+};
 }; // namespace ns
\ No newline at end of file
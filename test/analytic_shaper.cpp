@@ -0,0 +1,108 @@
+#include <nested-shaper/AnalyticShaper.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <math.h>
+
+using namespace ns;
+
+TEST_CASE("AnalyticShaper") {
+    using Shaper = AnalyticShaper<double, 4, 3, 8, 3>;
+    using polynomial_type = Shaper::polynomial_type;
+
+    SECTION("Constant") {
+        Shaper shaper{2.5, 0.3, 0.2, 0.1};
+        const array<double, 4> result = shaper.evaluate(1.0);
+        REQUIRE(result[0] == 2.5);
+        REQUIRE(result[1] == 0.0);
+        REQUIRE(result[3] == 0.0);
+    }
+
+    SECTION("Step with same windows, eq. (8)") {
+        constexpr double A = 10.0;
+        constexpr double T = 0.5;
+        Shaper shaper{0.0, T, T, T};
+        REQUIRE(shaper.append(0.0, polynomial_type{{A, 0.0, 0.0, 0.0}}));
+
+        for(int i = 0; i <= 200; i++) {
+            const double t = 0.01 * double(i) - 0.2;
+            double expected[4] = {0.0, 0.0, 0.0, 0.0};
+            for(int k = 0; k <= 3; k++) {
+                const double binomial = k == 0 || k == 3 ? 1.0 : 3.0;
+                const double x = t - double(k) * T;
+                if(x >= 0.0) {
+                    const double sign = k % 2 == 0 ? 1.0 : -1.0;
+                    expected[0] += sign * binomial * x * x * x;
+                    expected[1] += sign * binomial * 3.0 * x * x;
+                    expected[2] += sign * binomial * 6.0 * x;
+                    expected[3] += sign * binomial * 6.0;
+                }
+            }
+
+            const array<double, 4> result = shaper.evaluate(t);
+            for(int k = 0; k < 4; k++) {
+                REQUIRE_THAT(result[size_t(k)], Catch::Matchers::WithinAbs(A / 6.0 / (T * T * T) * expected[k], 1e-9));
+            }
+        }
+
+        REQUIRE(shaper.size() == 0);
+        REQUIRE(shaper.evaluate(1000.0)[0] == A);
+    }
+
+    SECTION("Jerk-limited reference") {
+        // Ramp from 0 to 1 during [0, 1], then hold.
+        Shaper shaper{0.0, 0.2, 0.1, 0.05};
+        REQUIRE(shaper.append(0.0, polynomial_type{{0.0, 1.0, 0.0, 0.0}}));
+        REQUIRE(shaper.append(1.0, polynomial_type{{1.0, 0.0, 0.0, 0.0}}));
+        REQUIRE_FALSE(shaper.size() == 0);
+
+        // Derivatives are consistent with central differences of the position.
+        constexpr double h = 1e-4;
+        for(int i = 1; i < 160; i++) {
+            const double t = 0.01 * double(i);
+            Shaper copy = shaper;
+            const double before = copy.evaluate(t - h)[0];
+            const array<double, 4> result = copy.evaluate(t);
+            const double after = copy.evaluate(t + h)[0];
+            REQUIRE_THAT(result[1], Catch::Matchers::WithinAbs((after - before) / (2.0 * h), 1e-6));
+            REQUIRE(result[1] >= 0.0);
+            REQUIRE(result[1] <= 1.0 + 1e-12);
+        }
+
+        // Middle of the ramp is delayed by half of the windows.
+        REQUIRE_THAT(shaper.evaluate(0.5 + 0.175)[0], Catch::Matchers::WithinAbs(0.5, 1e-12));
+        REQUIRE_THAT(shaper.evaluate(1.35)[0], Catch::Matchers::WithinAbs(1.0, 1e-12));
+        REQUIRE(shaper.size() == 0);
+        REQUIRE_THAT(shaper.evaluate(1.0e6)[0], Catch::Matchers::WithinAbs(1.0, 1e-12));
+    }
+
+    SECTION("Invalid segments") {
+        AnalyticShaper<double, 2, 1, 2, 1> shaper{0.0, 1.0};
+        REQUIRE(shaper.append(1.0, array<double, 2>{{1.0, 0.0}}));
+        REQUIRE(shaper.append(2.0, array<double, 2>{{2.0, 0.0}}));
+        REQUIRE(shaper.size() == 2);
+        shaper.evaluate(2.5);
+        REQUIRE(shaper.size() == 1);
+        REQUIRE(shaper.append(3.0, array<double, 2>{{0.0, 0.0}}));
+        REQUIRE_THAT(shaper.evaluate(3.5)[0], Catch::Matchers::WithinAbs(1.0, 1e-12));
+    }
+
+    SECTION("Same results with sampled shaper") {
+        // Windows of capacity * dt, sampled shaper converges as dt decreases.
+        constexpr double dt = 1e-4;
+        Shaper analytic{0.0, 0.1, 0.05, 0.02};
+        NestedShaperEuclideanRecursive<double, 3, 1000, 500, 200> sampled{0.0};
+        REQUIRE(analytic.append(0.0, polynomial_type{{0.0, 0.0, 3.0, -2.0}})); // smooth step 3t^2 - 2t^3
+        REQUIRE(analytic.append(1.0, polynomial_type{{1.0, 0.0, 0.0, 0.0}}));
+
+        for(int i = 0; i < 15000; i++) {
+            const double t = dt * double(i);
+            const double input = t < 1.0 ? (3.0 - 2.0 * t) * t * t : 1.0;
+            const array<double, 3> samples = sampled.convolute(input, dt);
+            // central point of the derivative queue, and half a sample of each stage
+            const array<double, 4> expected = analytic.evaluate(t - dt + 1.5 * dt);
+            REQUIRE_THAT(samples[0], Catch::Matchers::WithinAbs(expected[0], 1e-6));
+            REQUIRE_THAT(samples[1], Catch::Matchers::WithinAbs(expected[1], 1e-3));
+        }
+    }
+}
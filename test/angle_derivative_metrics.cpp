@@ -42,4 +42,25 @@ TEST_CASE("AngleDerivativeMetrics") {
 
     REQUIRE_THAT(derivatives_3_3[2][0], Catch::Matchers::WithinRel(0.4f, 1e-4f));
     REQUIRE_THAT(derivatives_3_3[2][1], Catch::Matchers::WithinRel(3.0f, 1e-4f));
-}
\ No newline at end of file
+
+    // Samples stepping across pi are unwrapped against the previous one, position is wrapped back to [-pi, pi)
+    Queue<float, 5> q_5;
+    Queue<array<float, 2>, 5> q_5_2;
+    for(size_t i = 0; i < 5; i++) {
+        const float angle = wrap(3.0f + 0.1f * float(i), -M_PIf, M_PIf);
+        q_5.push(angle);
+        q_5_2.push(array<float, 2>{angle, -angle});
+    }
+    AngleDerivativeMetrics<float, 5> edm_5;
+    array<float, 5> derivatives_5 = edm_5.operator()(q_5.forwardConstIterator(), q_5.backwardConstIterator(), 0.1f);
+    REQUIRE_THAT(derivatives_5[0], Catch::Matchers::WithinRel(3.2f - 2.0f * M_PIf, 1e-4f));
+    REQUIRE_THAT(derivatives_5[1], Catch::Matchers::WithinRel(1.0f, 1e-3f));
+    REQUIRE_THAT(derivatives_5[2], Catch::Matchers::WithinAbs(0.0f, 1e-2f));
+
+    AngleDerivativeMetricsArray<float, 2, 5> edm_5_2;
+    array<array<float, 5>, 2> derivatives_5_2 = edm_5_2.operator()(q_5_2.forwardConstIterator(), q_5_2.backwardConstIterator(), 0.1f);
+    REQUIRE_THAT(derivatives_5_2[0][0], Catch::Matchers::WithinRel(3.2f - 2.0f * M_PIf, 1e-4f));
+    REQUIRE_THAT(derivatives_5_2[0][1], Catch::Matchers::WithinRel(1.0f, 1e-3f));
+    REQUIRE_THAT(derivatives_5_2[1][0], Catch::Matchers::WithinRel(2.0f * M_PIf - 3.2f, 1e-4f));
+    REQUIRE_THAT(derivatives_5_2[1][1], Catch::Matchers::WithinRel(-1.0f, 1e-3f));
+}
@@ -0,0 +1,53 @@
+#include <nested-shaper/metrics/angle_mean_running_sum_metrics.hpp>
+#include <nested-shaper/metrics/angle_mean_cumulative_metrics.hpp>
+#include <nested-shaper/MovingMetrics.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("AngleMeanRunningSumMetrics") {
+    SECTION("Mean") {
+        Queue<float, 3> q;
+        q.fill(0.1f);
+
+        AngleMeanRunningSumMetrics<float> metrics{};
+        metrics.initialize(0.1f, 3);
+
+        q.push(0.7f + 2.0f * M_PIf);
+        const float mean = metrics(0.1f, 0.1f, 0.7f + 2.0f * M_PIf, q.forwardConstIterator(), q.backwardConstIterator());
+        REQUIRE(fabs(mean - 0.3f) < 1e-4f);
+    }
+
+    SECTION("Same results with AngleMeanCumulativeMetrics") {
+        MovingMetrics<double, 8, AngleMeanRunningSumMetrics<double>> running_sum{3.0};
+        MovingMetrics<double, 8, AngleMeanCumulativeMetrics<double>> cumulative{3.0};
+
+        // Rotating across -pi and pi, the running sum mean follows the wrap, and stays in [-pi, pi).
+        for(int i = 0; i < 5000; i++) {
+            const double input = wrap(3.0 + 0.05 * double(i), -M_PI, M_PI);
+            const double mean = running_sum.convolute(input);
+            REQUIRE(mean >= -M_PI);
+            REQUIRE(mean < M_PI);
+            REQUIRE_THAT(wrap(mean - cumulative.convolute(input), -M_PI, M_PI), Catch::Matchers::WithinAbs(0.0, 1e-3));
+            if(i >= 8) {
+                REQUIRE_THAT(wrap(mean - (3.0 + 0.05 * (double(i) - 3.5)), -M_PI, M_PI), Catch::Matchers::WithinAbs(0.0, 1e-9));
+            }
+        }
+    }
+
+    SECTION("Array") {
+        MovingMetrics<array<double, 2>, 5, AngleMeanRunningSumMetricsArray<double, 2>> running_sum{array<double, 2>{{0.0, 1.0}}};
+        MovingMetrics<array<double, 2>, 5, AngleMeanCumulativeMetricsArray<double, 2>> cumulative{array<double, 2>{{0.0, 1.0}}};
+
+        for(int i = 0; i < 100; i++) {
+            const array<double, 2> input{{wrap(0.2 * double(i), -M_PI, M_PI), 1.0 - 0.01 * double(i)}};
+            const array<double, 2> mean = running_sum.convolute(input);
+            const array<double, 2> expected = cumulative.convolute(input);
+            REQUIRE(mean[0] >= -M_PI);
+            REQUIRE(mean[0] < M_PI);
+            REQUIRE_THAT(wrap(mean[0] - expected[0], -M_PI, M_PI), Catch::Matchers::WithinAbs(0.0, 1e-2));
+            REQUIRE_THAT(mean[1], Catch::Matchers::WithinAbs(expected[1], 1e-6));
+        }
+    }
+}
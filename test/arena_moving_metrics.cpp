@@ -0,0 +1,89 @@
+#include <nested-shaper/ArenaMovingMetrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("ArenaMovingMetrics", "[ArenaMovingMetrics]") {
+    SECTION("Same results with MovingMetrics") {
+        double storage[7];
+        Arena<double> arena{storage};
+        ArenaMovingMetrics<double, EuclideanMeanCumulativeMetrics<double>> arena_metrics{0.0, arena, 7};
+        MovingMetrics<double, 7, EuclideanMeanCumulativeMetrics<double>> moving_metrics{0.0};
+        REQUIRE(arena_metrics.capacity() == 7);
+
+        for(int i = 0; i < 30; i++) {
+            const double input = double(i % 5);
+            REQUIRE(arena_metrics.convolute(input) == moving_metrics.convolute(input));
+        }
+
+        arena_metrics.initialize(1.0, 4);
+        moving_metrics.initialize(1.0, 4);
+        REQUIRE(arena_metrics.extent() == 7);
+        REQUIRE(arena_metrics.capacity() == 4);
+        for(int i = 0; i < 30; i++) {
+            const double input = double(i % 3);
+            REQUIRE(arena_metrics.convolute(input) == moving_metrics.convolute(input));
+        }
+    }
+}
+
+TEST_CASE("ArenaShaperMetrics", "[ArenaShaperMetrics]") {
+    using ArenaShaper = NestedShaperEuclideanRecursiveArena<double, 5, 3>;
+    using Shaper = NestedShaperEuclideanRecursive<double, 5, 7, 3, 2>;
+
+    SECTION("Same results with ShaperMetrics") {
+        double storage[Arena<double>::required(7U, 3U, 2U)];
+        Arena<double> arena{storage};
+        ArenaShaper arena_shaper{1.0, arena, 7U, 3U, 2U};
+        Shaper shaper{1.0};
+        REQUIRE(arena.remaining() == 0);
+
+        for(int i = 0; i < 50; i++) {
+            const double input = double(i % 11) * 0.5;
+            const array<double, 5> derivatives = shaper.convolute(input, 0.01);
+            const array<double, 5> derivatives_arena = arena_shaper.convolute(input, 0.01);
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE(derivatives[k] == derivatives_arena[k]);
+            }
+        }
+    }
+
+    SECTION("Reinitialize with smaller capacities") {
+        double storage[32];
+        Arena<double> arena{storage};
+        ArenaShaper arena_shaper{0.0, arena, 16U, 8U, 8U};
+        Shaper shaper{0.0, 5U, 2U, 2U};
+        arena_shaper.initialize(2.0, 5U, 2U, 2U);
+        shaper.initialize(2.0, 5U, 2U, 2U);
+
+        for(int i = 0; i < 50; i++) {
+            const double input = double(i % 7);
+            const array<double, 5> derivatives = shaper.convolute(input, 0.01);
+            const array<double, 5> derivatives_arena = arena_shaper.convolute(input, 0.01);
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE(derivatives[k] == derivatives_arena[k]);
+            }
+        }
+    }
+
+    SECTION("Exhausted arena") {
+        double storage[8];
+        Arena<double> arena{storage};
+        ArenaShaper arena_shaper{1.0, arena, 7U, 3U, 2U};
+        REQUIRE_FALSE(arena_shaper.valid());
+
+        // Stages without storage refuse to run, and hold the value of initialize
+        for(int i = 0; i < 10; i++) {
+            const array<double, 5> derivatives = arena_shaper.convolute(double(i), 0.01);
+            REQUIRE(derivatives[0] == 1.0);
+            for(size_t k = 1; k < 5; k++) {
+                REQUIRE_THAT(derivatives[k], Catch::Matchers::WithinAbs(0.0, 1e-9));
+            }
+        }
+        arena_shaper.initialize(2.0, 2U, 2U, 2U);
+        REQUIRE_FALSE(arena_shaper.valid());
+        REQUIRE(arena_shaper.convolute(3.0, 0.01)[0] == 2.0);
+    }
+}
@@ -0,0 +1,127 @@
+#include <nested-shaper/ArenaQueue.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ns;
+
+TEST_CASE("Arena", "[Arena]") {
+    SECTION("Allocate") {
+        int storage[10];
+        Arena<int> arena{storage};
+        REQUIRE(arena.size() == 10);
+        REQUIRE(arena.required(3U, 4U, 2U) == 9);
+
+        int* a = arena.allocate(3);
+        int* b = arena.allocate(4);
+        REQUIRE(a == storage);
+        REQUIRE(b == storage + 3);
+        REQUIRE(arena.used() == 7);
+        REQUIRE(arena.remaining() == 3);
+
+        arena.reset();
+        REQUIRE(arena.used() == 0);
+        REQUIRE(arena.allocate(10) == storage);
+    }
+}
+
+TEST_CASE("ArenaQueue", "[ArenaQueue]") {
+    SECTION("Constructor") {
+        int storage[8];
+        Arena<int> arena{storage};
+        ArenaQueue<int> q1{arena, 5};
+        ArenaQueue<int> q2{arena, 3};
+        REQUIRE(q1.extent() == 5);
+        REQUIRE(q1.capacity() == 5);
+        REQUIRE(q1.isEmpty());
+        REQUIRE(q2.capacity() == 3);
+        REQUIRE(arena.remaining() == 0);
+
+        ArenaQueue<int> q3;
+        REQUIRE_FALSE(q3.valid());
+        REQUIRE(q3.capacity() == 0);
+        REQUIRE(q3.bind(storage, 8));
+        REQUIRE(q3.valid());
+        REQUIRE(q3.capacity() == 8);
+    }
+
+    SECTION("Exhausted arena") {
+        int storage[4];
+        Arena<int> arena{storage};
+        REQUIRE(arena.allocate(5) == nullptr);
+
+        ArenaQueue<int> q1{arena, 3};
+        ArenaQueue<int> q2{arena, 3};
+        REQUIRE(q1.valid());
+        REQUIRE_FALSE(q2.valid());
+        REQUIRE(q2.extent() == 0);
+        REQUIRE(q2.capacity() == 0);
+        REQUIRE(arena.remaining() == 1);
+        REQUIRE_FALSE(q2.bind(arena, 2));
+        REQUIRE(q2.bind(arena, 1));
+    }
+
+    SECTION("Bulk push and segments of Queue") {
+        int storage[4];
+        ArenaQueue<int> q{storage, 4};
+        const int values[6] = {1, 2, 3, 4, 5, 6};
+        q.pushN(values, 3);
+        q.pushN(values + 3, 3);
+        REQUIRE(q.size() == 4);
+        REQUIRE(q.back() == 3);
+        REQUIRE(q.front() == 6);
+        REQUIRE(q.segments().first.size + q.segments().second.size == 4);
+    }
+
+    SECTION("Push and Pop, Front and Back") {
+        int storage[3];
+        ArenaQueue<int> q{storage, 3};
+        for(int i = 1; i <= 20; i++) {
+            q.push(i);
+        }
+        REQUIRE(q.size() == 3);
+        REQUIRE(q.isFull());
+        REQUIRE(q.front() == 20);
+        REQUIRE(q.front(2) == 18);
+        REQUIRE(q.back() == 18);
+        REQUIRE(q.back(1) == 19);
+
+        q.pop();
+        REQUIRE(q.back() == 19);
+        q.push(21);
+        REQUIRE(q.shift(22) == 19);
+        REQUIRE(q.front() == 22);
+        REQUIRE(q.back() == 20);
+    }
+
+    SECTION("Iterators") {
+        int storage[5];
+        ArenaQueue<int> q{storage, 5};
+        for(int i = 1; i <= 7; i++) {
+            q.push(i);
+        }
+        // Queue contains 3, 4, 5, 6, 7
+
+        QueueIterator<int> forwardIterator = q.forwardIterator();
+        for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
+            REQUIRE(*forwardIterator == int(i) + 3);
+        }
+
+        QueueConstIterator<int> backwardConstIterator = q.backwardConstIterator();
+        REQUIRE(*(backwardConstIterator - 4U) == 3);
+        for(size_t i = 0; i < backwardConstIterator.size; ++i, --backwardConstIterator) {
+            REQUIRE(*backwardConstIterator == 7 - int(i));
+        }
+    }
+
+    SECTION("Resize and Fill") {
+        int storage[8];
+        ArenaQueue<int> q{storage, 8};
+        q.resize(3);
+        q.fill(7);
+        REQUIRE(q.extent() == 8);
+        REQUIRE(q.size() == 3);
+        q.push(8);
+        REQUIRE(q.front() == 8);
+        REQUIRE(q.back() == 7);
+        REQUIRE(q.back(2) == 8);
+    }
+}
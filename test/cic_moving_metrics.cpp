@@ -0,0 +1,115 @@
+#include <nested-shaper/CICMovingMetrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdint.h>
+
+using namespace ns;
+
+// Exact nested moving averages, by the integer composite kernel and a single rounding.
+template<size_t Size>
+struct CompositeKernel {
+    int64_t kernel[Size]{};
+    size_t size{1};
+    int64_t gain{1};
+
+    CompositeKernel() { kernel[0] = 1; }
+
+    void box(const size_t& capacity) {
+        int64_t result[Size]{};
+        for(size_t i = 0; i < size + capacity - 1U; i++) {
+            for(size_t j = 0; j < capacity; j++) {
+                if(i >= j && i - j < size) {
+                    result[i] += kernel[i - j];
+                }
+            }
+        }
+
+        size += capacity - 1U;
+        gain *= int64_t(capacity);
+        for(size_t i = 0; i < size; i++) {
+            kernel[i] = result[i];
+        }
+    }
+
+    int64_t convolute(const int64_t* history, const size_t& n, const int64_t& value) const {
+        int64_t sum{0};
+        for(size_t k = 0; k < size; k++) {
+            sum += kernel[k] * ((n >= k ? history[n - k] : value) - value);
+        }
+
+        return divide_rounded(sum, gain) + value;
+    }
+};
+
+TEST_CASE("CICMovingMetricsNested") {
+    SECTION("Constructor") {
+        CICMovingMetricsNested<int32_t, 7, 5, 3> cic{10};
+        REQUIRE(cic.stages == 3);
+        REQUIRE(cic.capacity(0) == 7);
+        REQUIRE(cic.capacity(2) == 3);
+        REQUIRE(cic.convolute(10) == 10);
+
+        CICMovingMetricsNested<int32_t, 7, 5, 3> cic2{-4, 2U, 5U, 1U};
+        REQUIRE(cic2.capacity(0) == 2);
+        REQUIRE(cic2.capacity(2) == 1);
+        REQUIRE(cic2.convolute(-4) == -4);
+    }
+
+    SECTION("Same results with the composite kernel") {
+        constexpr size_t n = 20000U;
+        static int64_t history[n];
+
+        CompositeKernel<32> reference;
+        reference.box(9U);
+        reference.box(6U);
+        reference.box(3U);
+        CICMovingMetricsNested<int64_t, 10, 6, 4> cic{-1000, 9U, 6U, 3U};
+
+        uint32_t seed{7U};
+        for(size_t i = 0; i < n; i++) {
+            seed = seed * 1664525U + 1013904223U;
+            history[i] = int64_t(seed >> 12U) - 500000; // integrators wrap around within a few thousands samples
+            REQUIRE(cic.convolute(history[i]) == reference.convolute(history, i, -1000));
+        }
+    }
+
+    SECTION("Equal extents and convoluteBlock") {
+        CompositeKernel<32> reference;
+        for(size_t s = 0; s < 4U; s++) {
+            reference.box(5U);
+        }
+        CICMovingMetricsNested<int32_t, 5, 5, 5, 5> cic{3};
+
+        static int64_t history[1000];
+        int32_t input[1000];
+        int32_t output[1000];
+        for(size_t i = 0; i < 1000U; i++) {
+            input[i] = int32_t((i * 7919U) % 2001U) - 1000;
+            history[i] = input[i];
+        }
+
+        cic.convoluteBlock(input, output, 1000U);
+        for(size_t i = 0; i < 1000U; i++) {
+            REQUIRE(output[i] == reference.convolute(history, i, 3));
+        }
+
+        cic.initialize(0);
+        REQUIRE(cic.convolute(625) == 1); // 625 / 5^4
+    }
+
+    SECTION("NestedShaperCIC") {
+        NestedShaperCIC<int64_t, 3, 8, 4> shaper{int64_t(1) << 16};
+        const array<int64_t, 3> hold = shaper.convolute(int64_t(1) << 16, 1);
+        REQUIRE(hold[0] == int64_t(1) << 16);
+        REQUIRE(hold[1] == 0);
+        REQUIRE(hold[2] == 0);
+
+        // Ramp of 1 << 16 per sample, velocity is exact once the kernel is filled.
+        array<int64_t, 3> derivatives{};
+        for(int64_t i = 2; i < 20; i++) {
+            derivatives = shaper.convolute(i << 16, 1);
+        }
+        REQUIRE(derivatives[1] == int64_t(1) << 16);
+        REQUIRE(derivatives[2] == 0);
+    }
+}
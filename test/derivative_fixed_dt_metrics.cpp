@@ -0,0 +1,116 @@
+#include <nested-shaper/metrics/euclidean_derivative_fixed_dt_metrics.hpp>
+#include <nested-shaper/metrics/angle_derivative_fixed_dt_metrics.hpp>
+#include <nested-shaper/metrics/euclidean_derivative_backward_metrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <type_traits>
+
+using namespace ns;
+
+TEST_CASE("DerivativeFixedDtMetrics") {
+    SECTION("Euclidean") {
+        Queue<float, 3> q;
+        q.push(1.0f);
+        q.push(2.0f);
+        q.push(4.0f);
+
+        EuclideanDerivativeFixedDtMetrics<float, 3> metrics{0.1f};
+        const EuclideanDerivativeFixedDtMetrics<float, 3>& scaled = metrics;
+        array<float, 3> derivatives = scaled(q.forwardConstIterator(), q.backwardConstIterator(), 0.1f);
+        REQUIRE(derivatives[0] == 2.0f);
+        REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinRel(15.0f, 1e-4f));
+        REQUIRE_THAT(derivatives[2], Catch::Matchers::WithinRel(100.0f, 1e-4f));
+
+        // Rescaled for the new dt
+        metrics.initialize(0.2f);
+        derivatives = scaled(q.forwardConstIterator(), q.backwardConstIterator(), 0.2f);
+        REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinRel(7.5f, 1e-4f));
+        REQUIRE_THAT(derivatives[2], Catch::Matchers::WithinRel(25.0f, 1e-4f));
+    }
+
+    SECTION("Backward coefficients") {
+        Queue<double, 4> q;
+        q.push(1.0);
+        q.push(2.0);
+        q.push(4.0);
+        q.push(7.0);
+
+        EuclideanDerivativeBackwardMetrics<double, 4> backward;
+        EuclideanDerivativeFixedDtMetrics<double, 4, BACKWARD_FINITE_DIFFERENCE_COEFFICIENTS<double, 4>, 3> backward_fixed{0.1};
+        const array<double, 4> expected = backward(q.forwardConstIterator(), q.backwardConstIterator(), 0.1);
+        const array<double, 4> derivatives = backward_fixed(q.forwardConstIterator(), q.backwardConstIterator(), 0.1);
+        REQUIRE(derivatives[0] == 7.0);
+        for(size_t k = 1; k < 4; k++) {
+            REQUIRE_THAT(derivatives[k], Catch::Matchers::WithinRel(expected[k], 1e-12));
+        }
+    }
+
+    SECTION("Same results with central metrics") {
+        NestedShaperEuclideanRecursive<double, 7, 11, 7, 3> euclidean{1.0};
+        NestedShaperEuclideanRecursiveFixedDt<double, 7, 11, 7, 3> euclidean_fixed{1.0, 0.01};
+        NestedShaperEuclideanRecursiveArray<double, 2, 5, 11, 7> euclidean_array{array<double, 2>{{1.0, -1.0}}};
+        NestedShaperEuclideanRecursiveFixedDtArray<double, 2, 5, 11, 7> euclidean_array_fixed{array<double, 2>{{1.0, -1.0}}, 0.01};
+        NestedShaperAngleRecursive<double, 5, 11, 7> angle{0.5};
+        NestedShaperAngleRecursiveFixedDt<double, 5, 11, 7> angle_fixed{0.5, 0.01};
+        NestedShaperAngleRecursiveArray<double, 2, 5, 11, 7> angle_array{array<double, 2>{{0.5, -0.5}}};
+        NestedShaperAngleRecursiveFixedDtArray<double, 2, 5, 11, 7> angle_array_fixed{array<double, 2>{{0.5, -0.5}}, 0.01};
+
+        // Rescaled by initialize
+        euclidean_fixed.initialize(1.0, 0.02);
+        euclidean_fixed.initialize(1.0, 0.01);
+        angle_fixed.initialize(0.5, 0.01);
+
+        // Absolute tolerance grows with 1 / dt^k, as the rounding of the scaled coefficients does.
+        double tolerance[7]{1e-9};
+        for(size_t k = 1; k < 7; k++) {
+            tolerance[k] = tolerance[k - 1] / 0.01;
+        }
+
+        for(size_t i = 0; i < 100; i++) {
+            const double input = 0.3 * double(i % 17U) - 0.01 * double(i);
+            const array<double, 2> input_array{{input, -input}};
+            const double angle_input = wrap(2.5 + 0.1 * double(i % 13U) + 0.02 * double(i), -M_PI, M_PI); // steps across pi
+            const array<double, 2> angle_input_array{{angle_input, -angle_input}};
+
+            const array<double, 7> expected = euclidean.convolute(input, 0.01);
+            const array<double, 7> derivatives = euclidean_fixed.convolute(input, 0.01);
+            for(size_t k = 0; k < 7; k++) {
+                REQUIRE_THAT(derivatives[k], Catch::Matchers::WithinRel(expected[k], 1e-9) || Catch::Matchers::WithinAbs(expected[k], tolerance[k]));
+            }
+
+            const array<array<double, 5>, 2> expected_array = euclidean_array.convolute(input_array, 0.01);
+            const array<array<double, 5>, 2> derivatives_array = euclidean_array_fixed.convolute(input_array, 0.01);
+            const array<double, 5> expected_angle = angle.convolute(angle_input, 0.01);
+            const array<double, 5> derivatives_angle = angle_fixed.convolute(angle_input, 0.01);
+            const array<array<double, 5>, 2> expected_angle_array = angle_array.convolute(angle_input_array, 0.01);
+            const array<array<double, 5>, 2> derivatives_angle_array = angle_array_fixed.convolute(angle_input_array, 0.01);
+            REQUIRE((-M_PI <= derivatives_angle[0] && derivatives_angle[0] < M_PI));
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE_THAT(derivatives_angle[k], Catch::Matchers::WithinRel(expected_angle[k], 1e-9) || Catch::Matchers::WithinAbs(expected_angle[k], tolerance[k]));
+                for(size_t m = 0; m < 2; m++) {
+                    REQUIRE_THAT(derivatives_array[m][k], Catch::Matchers::WithinRel(expected_array[m][k], 1e-9) || Catch::Matchers::WithinAbs(expected_array[m][k], tolerance[k]));
+                    REQUIRE_THAT(derivatives_angle_array[m][k], Catch::Matchers::WithinRel(expected_angle_array[m][k], 1e-9) || Catch::Matchers::WithinAbs(expected_angle_array[m][k], tolerance[k]));
+                }
+            }
+        }
+    }
+
+    SECTION("Time step is given with the value") {
+        // Coefficients can not be left unscaled, which would give zero derivatives
+        static_assert(!std::is_constructible<NestedShaperEuclideanRecursiveFixedDt<double, 3, 4, 3>, double>::value, "dt is required");
+
+        NestedShaperEuclideanRecursiveFixedDt<double, 3, 4, 3> shaper{0.0, 0.01};
+        array<double, 3> derivatives{};
+        for(size_t i = 0; i < 20; i++) {
+            derivatives = shaper.convolute(double(i), 0.01); // 100 / s
+        }
+        REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinRel(100.0, 1e-9));
+
+        shaper.initialize(0.0, 0.02);
+        for(size_t i = 0; i < 20; i++) {
+            derivatives = shaper.convolute(double(i), 0.02); // 50 / s
+        }
+        REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinRel(50.0, 1e-9));
+    }
+}
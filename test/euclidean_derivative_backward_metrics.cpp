@@ -0,0 +1,90 @@
+#include <nested-shaper/metrics/euclidean_derivative_backward_metrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+// 1 - 2t + 3t^2 - t^3 + 0.5t^4 and derivatives at t
+static double polynomial(const double& t, const size_t& order) {
+    switch(order) {
+    case 0: return 1.0 - 2.0 * t + 3.0 * t * t - t * t * t + 0.5 * t * t * t * t;
+    case 1: return -2.0 + 6.0 * t - 3.0 * t * t + 2.0 * t * t * t;
+    case 2: return 6.0 - 6.0 * t + 6.0 * t * t;
+    case 3: return -6.0 + 12.0 * t;
+    case 4: return 12.0;
+    default: return 0.0;
+    }
+}
+
+TEST_CASE("EuclideanDerivativeBackwardMetrics") {
+    SECTION("Exact for polynomials") {
+        const double dt = 0.1;
+        Queue<double, 2> q_2;
+        Queue<double, 5> q_5;
+        Queue<double, 9> q_9;
+        for(size_t i = 0; i < 9; i++) {
+            const double value = polynomial(dt * double(i), 0);
+            q_2.push(value);
+            q_5.push(value);
+            q_9.push(value);
+        }
+
+        const double t = dt * 8.0; // latest sample
+        const array<double, 5> derivatives_5 = EuclideanDerivativeBackwardMetrics<double, 5>{}(q_5.forwardConstIterator(), q_5.backwardConstIterator(), dt);
+        const array<double, 9> derivatives_9 = EuclideanDerivativeBackwardMetrics<double, 9>{}(q_9.forwardConstIterator(), q_9.backwardConstIterator(), dt);
+        for(size_t k = 0; k < 5; k++) {
+            REQUIRE_THAT(derivatives_5[k], Catch::Matchers::WithinAbs(polynomial(t, k), 1e-6));
+            REQUIRE_THAT(derivatives_9[k], Catch::Matchers::WithinAbs(polynomial(t, k), 1e-4));
+        }
+        for(size_t k = 5; k < 9; k++) {
+            REQUIRE_THAT(derivatives_9[k], Catch::Matchers::WithinAbs(0.0, 1e-1));
+        }
+
+        const array<double, 2> derivatives_2 = EuclideanDerivativeBackwardMetrics<double, 2>{}(q_2.forwardConstIterator(), q_2.backwardConstIterator(), dt);
+        REQUIRE(derivatives_2[0] == polynomial(t, 0));
+        REQUIRE_THAT(derivatives_2[1], Catch::Matchers::WithinAbs((polynomial(t, 0) - polynomial(t - dt, 0)) / dt, 1e-9));
+    }
+
+    SECTION("Array") {
+        Queue<array<float, 2>, 3> q;
+        q.push(array<float, 2>{{1.0f, -1.0f}});
+        q.push(array<float, 2>{{2.0f, -2.0f}});
+        q.push(array<float, 2>{{4.0f, -4.0f}});
+
+        const array<array<float, 3>, 2> derivatives = EuclideanDerivativeBackwardMetricsArray<float, 2, 3>{}(q.forwardConstIterator(), q.backwardConstIterator(), 0.1f);
+        REQUIRE(derivatives[0][0] == 4.0f);
+        REQUIRE_THAT(derivatives[0][1], Catch::Matchers::WithinRel(25.0f, 1e-4f));
+        REQUIRE_THAT(derivatives[0][2], Catch::Matchers::WithinRel(100.0f, 1e-4f));
+        REQUIRE(derivatives[1][0] == -4.0f);
+        REQUIRE_THAT(derivatives[1][1], Catch::Matchers::WithinRel(-25.0f, 1e-4f));
+    }
+
+    SECTION("Position without delay of the derivative queue") {
+        NestedShaperEuclideanRecursiveBackward<double, 5, 11, 7> shaper{1.0};
+        NestedShaperEuclideanRecursive<double, 1, 11, 7> reference{1.0};
+        for(size_t i = 0; i < 50; i++) {
+            const double input = 0.3 * double(i % 17U) - 0.01 * double(i);
+            REQUIRE(shaper.convolute(input, 0.01)[0] == reference.convolute(input, 0.01)[0]);
+        }
+    }
+
+    SECTION("Evaluate extrapolates past the latest sample") {
+        const double dt = 0.1;
+        NestedShaperEuclideanRecursiveBackward<double, 5, 1> shaper{polynomial(0.0, 0)};
+        NestedShaperEuclideanRecursive<double, 5, 1> central{polynomial(0.0, 0)};
+        for(size_t i = 0; i < 8; i++) {
+            shaper.convolute(polynomial(dt * double(i), 0), dt);
+            central.convolute(polynomial(dt * double(i), 0), dt);
+        }
+
+        // Results are at the latest sample, 0.7, and evaluate(1, dt) is the prediction of the next sample.
+        const array<double, 5> predicted = shaper.evaluate(1.0, dt);
+        const array<double, 5> next = shaper.convolute(polynomial(dt * 8.0, 0), dt);
+        REQUIRE_THAT(predicted[0], Catch::Matchers::WithinAbs(polynomial(dt * 8.0, 0), 1e-9));
+        REQUIRE_THAT(predicted[0], Catch::Matchers::WithinAbs(next[0], 1e-9));
+
+        // Central results are at 0.5, evaluate(1, dt) is the sample at 0.6 within the queue.
+        REQUIRE_THAT(central.evaluate(1.0, dt)[0], Catch::Matchers::WithinAbs(polynomial(dt * 6.0, 0), 1e-9));
+    }
+}
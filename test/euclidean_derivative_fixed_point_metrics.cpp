@@ -0,0 +1,55 @@
+#include <nested-shaper/metrics/euclidean_derivative_fixed_point_metrics.hpp>
+#include <nested-shaper/metrics/euclidean_derivative_metrics.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdint.h>
+
+using namespace ns;
+
+TEST_CASE("EuclideanDerivativeFixedPointMetrics") {
+    SECTION("Coefficients") {
+        constexpr array<array<int64_t, 3>, 2> coefficients = CENTRAL_FINITE_DIFFERENCE_COEFFICIENTS_FIXED_POINT<int64_t, 3, 16>::value;
+        REQUIRE(coefficients[0][0] == -32768);
+        REQUIRE(coefficients[0][2] == 32768);
+        REQUIRE(coefficients[1][1] == -131072);
+    }
+
+    SECTION("Same results with floating point, within rounding") {
+        Queue<int64_t, 5> q;
+        Queue<double, 5> q_double;
+        EuclideanDerivativeFixedPointMetrics<int64_t, 5, 20> metrics;
+        EuclideanDerivativeMetrics<double, 5> metrics_double;
+
+        for(int64_t i = 0; i < 20; i++) {
+            const int64_t sample = i * i * i * 1000 - i * 70000; // counts
+            q.push(sample);
+            q_double.push(double(sample));
+            if(!q.isFull()) {
+                continue;
+            }
+
+            const array<int64_t, 5> derivatives = metrics(q.forwardConstIterator(), q.backwardConstIterator(), 2);
+            const array<double, 5> derivatives_double = metrics_double(q_double.forwardConstIterator(), q_double.backwardConstIterator(), 2.0);
+            for(size_t k = 0; k < 5; k++) {
+                const double error = double(derivatives[k]) - derivatives_double[k];
+                REQUIRE(error <= 1.0);
+                REQUIRE(error >= -1.0);
+            }
+        }
+    }
+
+    SECTION("Array") {
+        Queue<array<int32_t, 2>, 3> q;
+        q.push(array<int32_t, 2>{{0, 100}});
+        q.push(array<int32_t, 2>{{10, 100}});
+        q.push(array<int32_t, 2>{{20, 90}});
+
+        EuclideanDerivativeFixedPointMetricsArray<int32_t, 2, 3, 8> metrics;
+        const array<array<int32_t, 3>, 2> derivatives = metrics(q.forwardConstIterator(), q.backwardConstIterator(), 1);
+        REQUIRE(derivatives[0][0] == 10);
+        REQUIRE(derivatives[0][1] == 10);
+        REQUIRE(derivatives[0][2] == 0);
+        REQUIRE(derivatives[1][0] == 100);
+        REQUIRE(derivatives[1][1] == -5);
+        REQUIRE(derivatives[1][2] == -10);
+    }
+}
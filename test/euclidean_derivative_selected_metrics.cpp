@@ -0,0 +1,62 @@
+#include <nested-shaper/metrics/euclidean_derivative_selected_metrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <nested-shaper/MirroredQueue.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("EuclideanDerivativeSelectedMetrics") {
+    SECTION("Selected orders") {
+        Queue<float, 3> q;
+        q.push(1.0f);
+        q.push(2.0f);
+        q.push(4.0f);
+
+        const array<float, 1> acceleration = EuclideanDerivativeSelectedMetrics<float, 3, derivative_orders<2>>{}(q.forwardConstIterator(), q.backwardConstIterator(), 0.1f);
+        REQUIRE_THAT(acceleration[0], Catch::Matchers::WithinRel(100.0f, 1e-4f));
+
+        const array<float, 2> position_velocity = EuclideanDerivativeSelectedMetrics<float, 3, derivative_orders<0, 1>>{}(q.forwardConstIterator(), q.backwardConstIterator(), 0.1f);
+        REQUIRE(position_velocity[0] == 2.0f);
+        REQUIRE_THAT(position_velocity[1], Catch::Matchers::WithinRel(15.0f, 1e-4f));
+    }
+
+    SECTION("Same results with NestedShaperEuclideanRecursive") {
+        NestedShaperEuclideanRecursive<double, 5, 11, 7, 3> shaper{1.0};
+        NestedShaperEuclideanRecursiveSelected<double, 5, derivative_orders<0, 2>, 11, 7, 3> shaper_selected{1.0};
+        NestedShaperEuclideanCumulativeSelected<double, 5, derivative_orders<4, 1>, 11, 7, 3> shaper_reordered{1.0};
+
+        for(size_t i = 0; i < 100; i++) {
+            const double input = 0.3 * double(i % 17U) - 0.01 * double(i);
+            const array<double, 5> derivatives = shaper.convolute(input, 0.01);
+            const array<double, 2> selected = shaper_selected.convolute(input, 0.01);
+            const array<double, 2> reordered = shaper_reordered.convolute(input, 0.01);
+
+            REQUIRE(selected[0] == derivatives[0]);
+            REQUIRE(selected[1] == derivatives[2]);
+            REQUIRE_THAT(reordered[0], Catch::Matchers::WithinAbs(derivatives[4], 1e-3));
+            REQUIRE_THAT(reordered[1], Catch::Matchers::WithinAbs(derivatives[1], 1e-9));
+        }
+    }
+
+    SECTION("Contiguous window of MirroredQueue") {
+        Queue<double, 5> q;
+        MirroredQueue<double, 5> mirrored;
+        EuclideanDerivativeSelectedMetrics<double, 5, derivative_orders<3, 0, 1>> metrics;
+
+        for(size_t i = 0; i < 20; i++) {
+            const double input = 0.5 * double(i * i % 7U) - 0.2 * double(i);
+            q.push(input);
+            mirrored.push(input);
+            if(!q.isFull()) {
+                continue;
+            }
+
+            const array<double, 3> expected = metrics(q.forwardConstIterator(), q.backwardConstIterator(), 0.01);
+            const array<double, 3> derivatives = metrics(mirrored.forwardConstIterator(), mirrored.backwardConstIterator(), 0.01);
+            for(size_t k = 0; k < 3; k++) {
+                REQUIRE(derivatives[k] == expected[k]);
+            }
+        }
+    }
+}
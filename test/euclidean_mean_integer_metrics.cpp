@@ -0,0 +1,95 @@
+#include <nested-shaper/metrics/euclidean_mean_integer_metrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdint.h>
+
+using namespace ns;
+
+TEST_CASE("EuclideanMeanIntegerMetrics") {
+    SECTION("Rounded mean") {
+        Queue<int, 4> q;
+        q.fill(1);
+
+        EuclideanMeanIntegerMetrics<int> metrics;
+        metrics.initialize(1, 4);
+        q.push(4);
+        REQUIRE(metrics(1, 1, 4, q.forwardConstIterator(), q.backwardConstIterator()) == 2); // 1, 1, 1, 4 : 1.75
+        q.push(-9);
+        REQUIRE(metrics(2, 1, -9, q.forwardConstIterator(), q.backwardConstIterator()) == -1); // 1, 1, 4, -9 : -0.75
+    }
+
+    SECTION("Array") {
+        Queue<array<int, 2>, 2> q;
+        q.fill(array<int, 2>{{0, 10}});
+
+        EuclideanMeanIntegerMetricsArray<int, 2> metrics;
+        metrics.initialize(array<int, 2>{{0, 10}}, 2);
+        q.push(array<int, 2>{{3, -10}});
+        const array<int, 2> mean = metrics(array<int, 2>{{0, 10}}, array<int, 2>{{0, 10}}, array<int, 2>{{3, -10}}, q.forwardConstIterator(), q.backwardConstIterator());
+        REQUIRE(mean[0] == 2);
+        REQUIRE(mean[1] == 0);
+    }
+
+    SECTION("No drift") {
+        MovingMetrics<int64_t, 37, EuclideanMeanIntegerMetrics<int64_t>> moving_metrics{1000};
+        Queue<int64_t, 37> window;
+        window.fill(1000);
+
+        uint32_t seed = 12345U;
+        for(int i = 0; i < 200000; i++) {
+            seed = seed * 1664525U + 1013904223U;
+            const int64_t input = int64_t(seed >> 8U) - int64_t(1 << 23);
+            window.push(input);
+
+            int64_t sum{0};
+            for(size_t j = 0; j < window.size(); j++) {
+                sum += window.back(j);
+            }
+
+            REQUIRE(moving_metrics.convolute(input) == divide_rounded(sum, int64_t(37)));
+        }
+    }
+
+    SECTION("NestedShaperInteger") {
+        NestedShaperInteger<int64_t, 3, 8, 4> shaper{0};
+
+        // constant velocity of 4096 per sample, in Q16
+        const int64_t velocity = int64_t(4096) << 16;
+        array<int64_t, 3> derivatives{};
+        for(int64_t i = 0; i < 100; i++) {
+            derivatives = shaper.convolute(velocity * i, 1);
+        }
+
+        // delay of the nested moving average (3.5 + 1.5 samples) and the central difference (1 sample)
+        REQUIRE(derivatives[0] == velocity * 93);
+        REQUIRE(derivatives[1] == velocity);
+        REQUIRE(derivatives[2] == 0);
+    }
+
+    SECTION("NestedShaperInteger of int32_t samples") {
+        // encoder counts around 100000, accumulated in int64_t by default
+        NestedShaperInteger<int32_t, 3, 10, 5> shaper{100000};
+        NestedShaperEuclideanCumulative<double, 3, 10, 5> shaper_double{100000.0};
+
+        array<int32_t, 3> derivatives{};
+        array<double, 3> derivatives_double{};
+        for(int32_t i = 0; i < 100; i++) {
+            const int32_t sample = 100000 + i * 3000 - (i * i) % 7 * 500;
+            derivatives = shaper.convolute(sample, 1);
+            derivatives_double = shaper_double.convolute(double(sample), 1.0);
+        }
+
+        for(size_t k = 0; k < 3; k++) {
+            REQUIRE(double(derivatives[k]) - derivatives_double[k] <= 2.0);
+            REQUIRE(double(derivatives[k]) - derivatives_double[k] >= -2.0);
+        }
+
+        // a wider time step with the same accumulator
+        BasicNestedShaperInteger<int32_t, int64_t, 20, 3, 10, 5> shaper_dt{100000};
+        for(int32_t i = 0; i < 100; i++) {
+            derivatives = shaper_dt.convolute(100000 + i * 3000, 1000);
+        }
+        REQUIRE(derivatives[1] == 3);
+        REQUIRE(derivatives[2] == 0);
+    }
+}
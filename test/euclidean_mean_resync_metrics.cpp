@@ -0,0 +1,95 @@
+#include <nested-shaper/metrics/euclidean_mean_resync_metrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <stdint.h>
+
+using namespace ns;
+
+TEST_CASE("EuclideanMeanResyncMetrics") {
+    SECTION("Mean") {
+        Queue<float, 4> q;
+        q.fill(1.0f);
+
+        EuclideanMeanResyncMetrics<float> metrics;
+        metrics.initialize(1.0f, 4);
+        q.push(5.0f);
+        float mean = metrics(1.0f, 1.0f, 5.0f, q.forwardConstIterator(), q.backwardConstIterator()); // 1, 1, 1, 5
+        REQUIRE(mean == 2.0f);
+        q.push(3.0f);
+        mean = metrics(mean, 1.0f, 3.0f, q.forwardConstIterator(), q.backwardConstIterator()); // 1, 1, 5, 3
+        REQUIRE(mean == 2.5f);
+    }
+
+    SECTION("Array") {
+        Queue<array<double, 2>, 2> q;
+        q.fill(array<double, 2>{{1.0, -1.0}});
+
+        EuclideanMeanResyncMetricsArray<double, 2> metrics;
+        metrics.initialize(array<double, 2>{{1.0, -1.0}}, 2);
+        q.push(array<double, 2>{{3.0, 2.0}});
+        array<double, 2> mean = metrics(array<double, 2>{{1.0, -1.0}}, array<double, 2>{{1.0, -1.0}}, array<double, 2>{{3.0, 2.0}}, q.forwardConstIterator(), q.backwardConstIterator());
+        REQUIRE(mean[0] == 2.0);
+        REQUIRE(mean[1] == 0.5);
+        q.push(array<double, 2>{{5.0, 4.0}});
+        mean = metrics(mean, array<double, 2>{{1.0, -1.0}}, array<double, 2>{{5.0, 4.0}}, q.forwardConstIterator(), q.backwardConstIterator()); // resynchronized
+        REQUIRE(mean[0] == 4.0);
+        REQUIRE(mean[1] == 3.0);
+    }
+
+    SECTION("Same results with cumulative metrics") {
+        MovingMetrics<double, 10, EuclideanMeanResyncMetrics<double>> resync{0.5};
+        MovingMetrics<double, 10, EuclideanMeanCumulativeMetrics<double>> cumulative{0.5};
+
+        for(int i = 0; i < 1000; i++) {
+            const double input = 0.37 * double((i * 17) % 23) - 3.1;
+            REQUIRE_THAT(resync.convolute(input), Catch::Matchers::WithinAbs(cumulative.convolute(input), 1e-12));
+        }
+
+        resync.initialize(2.0, 3);
+        cumulative.initialize(2.0, 3);
+        for(int i = 0; i < 100; i++) {
+            const double input = double(i % 7);
+            REQUIRE_THAT(resync.convolute(input), Catch::Matchers::WithinAbs(cumulative.convolute(input), 1e-12));
+        }
+    }
+
+    SECTION("Error is bounded over a long run") {
+        // float samples with large offsets, a plain running sum loses low-order bits on every sample.
+        constexpr size_t window = 64U;
+        MovingMetrics<float, window, EuclideanMeanResyncMetrics<float>> resync{0.0f};
+        Queue<double, window> exact;
+        exact.fill(0.0);
+
+        double sum{0.0};
+        double max_error{0.0};
+        uint32_t seed{1U};
+        for(size_t i = 0; i < 4000000U; i++) {
+            seed = seed * 1664525U + 1013904223U;
+            const float input = float(seed >> 8U) / float(1U << 24U) * 2000.0f + 1.0e5f;
+            sum += double(input) - exact.back();
+            exact.push(double(input));
+
+            const double error = double(resync.convolute(input)) - sum / double(window);
+            max_error = error > max_error ? error : (-error > max_error ? -error : max_error);
+        }
+
+        // Sums of the window are about 6.4e6, whose ULP is 0.5 in float.
+        // At most window roundings of half an ULP since the last resynchronization, divided by window, after 62500 windows.
+        REQUIRE(max_error < 0.25);
+    }
+
+    SECTION("NestedShaperEuclideanResync") {
+        NestedShaperEuclideanResync<double, 3, 7, 4> resync{1.0};
+        NestedShaperEuclideanCumulative<double, 3, 7, 4> cumulative{1.0};
+
+        for(int i = 0; i < 200; i++) {
+            const double input = 0.01 * double(i * i % 97);
+            const array<double, 3> derivatives = resync.convolute(input, 0.01);
+            const array<double, 3> expected = cumulative.convolute(input, 0.01);
+            for(size_t k = 0; k < 3; k++) {
+                REQUIRE_THAT(derivatives[k], Catch::Matchers::WithinAbs(expected[k], 1e-6));
+            }
+        }
+    }
+}
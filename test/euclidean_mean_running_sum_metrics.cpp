@@ -0,0 +1,65 @@
+#include <nested-shaper/metrics/euclidean_mean_running_sum_metrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("EuclideanMeanRunningSumMetrics") {
+    SECTION("Mean") {
+        Queue<float, 4> q;
+        q.fill(1.0f);
+
+        EuclideanMeanRunningSumMetrics<float> metrics;
+        metrics.initialize(1.0f, 4);
+        q.push(5.0f);
+        float mean = metrics(1.0f, 1.0f, 5.0f, q.forwardConstIterator(), q.backwardConstIterator()); // 1, 1, 1, 5
+        REQUIRE(mean == 2.0f);
+        q.push(3.0f);
+        mean = metrics(mean, 1.0f, 3.0f, q.forwardConstIterator(), q.backwardConstIterator()); // 1, 1, 5, 3
+        REQUIRE(mean == 2.5f);
+    }
+
+    SECTION("Array") {
+        Queue<array<double, 2>, 2> q;
+        q.fill(array<double, 2>{{1.0, -1.0}});
+
+        EuclideanMeanRunningSumMetricsArray<double, 2> metrics;
+        metrics.initialize(array<double, 2>{{1.0, -1.0}}, 2);
+        q.push(array<double, 2>{{3.0, 2.0}});
+        const array<double, 2> mean = metrics(array<double, 2>{{1.0, -1.0}}, array<double, 2>{{1.0, -1.0}}, array<double, 2>{{3.0, 2.0}}, q.forwardConstIterator(), q.backwardConstIterator());
+        REQUIRE(mean[0] == 2.0);
+        REQUIRE(mean[1] == 0.5);
+    }
+
+    SECTION("Same results with cumulative metrics") {
+        MovingMetrics<double, 10, EuclideanMeanRunningSumMetrics<double>> running_sum{0.5};
+        MovingMetrics<double, 10, EuclideanMeanCumulativeMetrics<double>> cumulative{0.5};
+
+        for(int i = 0; i < 1000; i++) {
+            const double input = 0.37 * double((i * 17) % 23) - 3.1;
+            REQUIRE_THAT(running_sum.convolute(input), Catch::Matchers::WithinAbs(cumulative.convolute(input), 1e-12));
+        }
+
+        running_sum.initialize(2.0, 3);
+        cumulative.initialize(2.0, 3);
+        for(int i = 0; i < 100; i++) {
+            const double input = double(i % 7);
+            REQUIRE_THAT(running_sum.convolute(input), Catch::Matchers::WithinAbs(cumulative.convolute(input), 1e-12));
+        }
+    }
+
+    SECTION("NestedShaperEuclideanRunningSum") {
+        NestedShaperEuclideanRunningSum<double, 3, 7, 4> running_sum{1.0};
+        NestedShaperEuclideanCumulative<double, 3, 7, 4> cumulative{1.0};
+
+        for(int i = 0; i < 200; i++) {
+            const double input = 0.01 * double(i * i % 97);
+            const array<double, 3> derivatives = running_sum.convolute(input, 0.01);
+            const array<double, 3> expected = cumulative.convolute(input, 0.01);
+            for(size_t k = 0; k < 3; k++) {
+                REQUIRE_THAT(derivatives[k], Catch::Matchers::WithinAbs(expected[k], 1e-6));
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include <nested-shaper/FusedMovingMetrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("FusedMovingMetricsNested", "[FusedMovingMetricsNested]") {
+    SECTION("Constructor") {
+        FusedMovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, 7, 3, 5> fused{1.0};
+        REQUIRE(fused.stages == 3);
+        REQUIRE(fused.capacity(0) == 7);
+        REQUIRE(fused.capacity(2) == 5);
+        REQUIRE(fused.convolute(1.0) == 1.0);
+
+        FusedMovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, 7, 3, 5> fused_capacities{1.0, 4U, 2U, 5U};
+        REQUIRE(fused_capacities.capacity(0) == 4);
+        REQUIRE(fused_capacities.capacity(1) == 2);
+        REQUIRE(alignof(FusedMovingMetricsNested<double, EuclideanMeanRecursiveMetrics<double>, 7, 3, 5>) == NESTED_SHAPER_CACHE_LINE_SIZE);
+    }
+
+    SECTION("Same results with MovingMetricsNested") {
+        FusedMovingMetricsNested<double, EuclideanMeanCumulativeMetrics<double>, 11, 4, 6, 2> fused{0.5};
+        MovingMetricsNested<double, EuclideanMeanCumulativeMetrics<double>, 11, 4, 6, 2> nested{0.5};
+
+        for(int i = 0; i < 100; i++) {
+            const double input = double((i * 7) % 13) - 0.25 * double(i);
+            REQUIRE(fused.convolute(input) == nested.convolute(input));
+        }
+
+        fused.initialize(2.0, 3U, 4U, 1U, 2U);
+        nested.initialize(2.0, 3U, 4U, 1U, 2U);
+        for(int i = 0; i < 100; i++) {
+            const double input = double(i % 5);
+            REQUIRE(fused.convolute(input) == nested.convolute(input));
+        }
+
+        double block[50];
+        for(int i = 0; i < 50; i++) {
+            block[i] = 0.1 * double(i * i);
+        }
+        fused.convoluteBlock(block, block, 50U);
+        for(int i = 0; i < 50; i++) {
+            REQUIRE(nested.convolute(0.1 * double(i * i)) == block[i]);
+        }
+    }
+
+    SECTION("Same results with ShaperMetrics") {
+        NestedShaperAngleRecursiveFused<double, 4, 9, 5, 3> fused{0.1};
+        NestedShaperAngleRecursive<double, 4, 9, 5, 3> shaper{0.1};
+
+        for(int i = 0; i < 100; i++) {
+            const double input = 0.2 * double(i % 40) - 3.0;
+            const array<double, 4> derivatives_fused = fused.convolute(input, 0.01);
+            const array<double, 4> derivatives = shaper.convolute(input, 0.01);
+            for(size_t k = 0; k < 4; k++) {
+                REQUIRE(derivatives_fused[k] == derivatives[k]);
+            }
+        }
+    }
+}
@@ -14,4 +14,16 @@ TEST_CASE("KahanBabushkaNeumaierAccumulator") {
     REQUIRE(fabs(sum - 2.0) < 1e-10);
     sum = accumulator.accumulate(sum, 1.0);
     REQUIRE(fabs(sum - 3.0) < 1e-10);
+}
+
+TEST_CASE("KahanBabushkaNeumaierSum") {
+    KahanBabushkaNeumaierSum<double> sum{};
+    sum.reset(1.0);
+    sum.add(1.0e100);
+    sum.add(1.0);
+    sum.add(-1.0e100);
+    REQUIRE(sum.sum() == 2.0);
+
+    sum.reset(3.0);
+    REQUIRE(sum.sum() == 3.0);
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <nested-shaper/LazyQueue.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("LazyQueue", "[LazyQueue]") {
+    SECTION("Constructor") {
+        LazyQueue<int, 5> q;
+        REQUIRE(q.extent == 5);
+        REQUIRE(q.capacity() == 5);
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.lazy() == 0);
+        REQUIRE(q.isEmpty());
+
+        LazyQueue<int, 8> q2(3U);
+        REQUIRE(q2.capacity() == 3);
+        REQUIRE(q2.isEmpty());
+    }
+
+    SECTION("Push and Pop, Front and Back") {
+        LazyQueue<int, 3> q;
+        for(int i = 1; i <= 20; i++) {
+            q.push(i);
+        }
+        REQUIRE(q.size() == 3);
+        REQUIRE(q.isFull());
+        REQUIRE(q.front() == 20);
+        REQUIRE(q.front(2) == 18);
+        REQUIRE(q.back() == 18);
+        REQUIRE(q.back(2) == 20);
+
+        q.pop();
+        REQUIRE(q.back() == 19);
+        REQUIRE(q.shift(21) == 19);
+        REQUIRE(q.front() == 21);
+        REQUIRE(q.back() == 20);
+    }
+
+    SECTION("Fill") {
+        LazyQueue<int, 4> q;
+        q.fill(7);
+        REQUIRE(q.isFull());
+        REQUIRE(q.lazy() == 4);
+        REQUIRE(q.back() == 7);
+        REQUIRE(q.front(3) == 7);
+
+        REQUIRE(q.shift(1) == 7);
+        REQUIRE(q.lazy() == 3);
+        q.push(2);
+        q.pop();
+        REQUIRE(q.lazy() == 1);
+        REQUIRE(q.size() == 3);
+        // Queue contains 7, 1, 2
+        REQUIRE(q.back() == 7);
+        REQUIRE(q.back(1) == 1);
+        REQUIRE(q.front() == 2);
+
+        REQUIRE(q.shift(3) == 7);
+        REQUIRE(q.lazy() == 0);
+        q.push(4);
+        REQUIRE(q.shift(5) == 1);
+        // Queue contains 2, 3, 4, 5
+        REQUIRE(q.back() == 2);
+        REQUIRE(q.front() == 5);
+    }
+
+    SECTION("Iterators") {
+        LazyQueue<int, 5> q;
+        q.fill(9);
+        q.shift(1);
+        q.shift(2);
+        // Queue contains 9, 9, 9, 1, 2
+
+        LazyQueueConstIterator<int> forwardIterator = q.forwardConstIterator();
+        REQUIRE(forwardIterator.size == 5);
+        REQUIRE(*forwardIterator++ == 9);
+        REQUIRE(*forwardIterator++ == 9);
+        REQUIRE(*forwardIterator++ == 9);
+        REQUIRE(*forwardIterator++ == 1);
+        REQUIRE(*forwardIterator == 2);
+        REQUIRE(*(q.forwardConstIterator() + 3) == 1);
+
+        LazyQueueConstIterator<int> backwardIterator = q.backwardConstIterator();
+        REQUIRE(*backwardIterator-- == 2);
+        REQUIRE(*backwardIterator-- == 1);
+        REQUIRE(*backwardIterator == 9);
+        REQUIRE(*(q.backwardConstIterator() - 4) == 9);
+    }
+
+    SECTION("Same results with Queue") {
+        MovingMetrics<double, 9, EuclideanMeanCumulativeMetrics<double>, LazyQueue> lazy{0.5, 7U};
+        MovingMetrics<double, 9, EuclideanMeanCumulativeMetrics<double>> eager{0.5, 7U};
+
+        for(int n = 0; n < 3; n++) {
+            for(int i = 0; i < 50; i++) {
+                const double input = 0.37 * double((i * 17) % 23) - 3.1;
+                REQUIRE(lazy.convolute(input) == eager.convolute(input));
+            }
+
+            lazy.initialize(double(n), 9U);
+            eager.initialize(double(n), 9U);
+        }
+    }
+
+    SECTION("NestedShaper") {
+        NestedShaperAngleCumulativeLazy<double, 3, 7, 4> lazy{1.0};
+        NestedShaperAngleCumulative<double, 3, 7, 4> eager{1.0};
+
+        for(int n = 0; n < 2; n++) {
+            for(int i = 0; i < 50; i++) {
+                const double input = 0.1 * double(i * i % 97);
+                const array<double, 3> derivatives = lazy.convolute(input, 0.01);
+                const array<double, 3> expected = eager.convolute(input, 0.01);
+                for(size_t k = 0; k < 3; k++) {
+                    REQUIRE(derivatives[k] == expected[k]);
+                }
+            }
+
+            lazy.initialize(-1.0);
+            eager.initialize(-1.0);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include <nested-shaper/MirroredQueue.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("MirroredQueue", "[MirroredQueue]") {
+    SECTION("Constructor") {
+        MirroredQueue<int, 4> q;
+        REQUIRE(q.extent == 4);
+        REQUIRE(q.capacity() == 4);
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.isEmpty());
+        REQUIRE_FALSE(q.isFull());
+
+        MirroredQueue<int, 8> q2(5);
+        REQUIRE(q2.capacity() == 5);
+        REQUIRE(q2.isEmpty());
+    }
+
+    SECTION("Push and Pop, Front and Back, Span") {
+        MirroredQueue<int, 3> q;
+        for(int i = 1; i <= 20; i++) {
+            q.push(i);
+
+            span<const int> window = q.span();
+            REQUIRE(window.size == q.size());
+            for(size_t j = 0; j < window.size; j++) {
+                REQUIRE(window[j] == q.back(j));
+            }
+        }
+        REQUIRE(q.isFull());
+        REQUIRE(q.front() == 20);
+        REQUIRE(q.front(2) == 18);
+        REQUIRE(q.back() == 18);
+        REQUIRE(q.back(2) == 20);
+
+        q.pop();
+        REQUIRE(q.size() == 2);
+        REQUIRE(q.back() == 19);
+        q.push(21);
+        REQUIRE(q.shift(22) == 19);
+        REQUIRE(q.span()[0] == 20);
+        REQUIRE(q.span()[1] == 21);
+        REQUIRE(q.span()[2] == 22);
+    }
+
+    SECTION("Iterators") {
+        MirroredQueue<int, 5> q;
+        for(int i = 1; i <= 6; i++) {
+            q.push(i);
+        }
+        q.pop();
+        q.pop();
+        // Queue contains 4, 5, 6
+
+        MirroredQueueConstIterator<int> forwardConstIterator = q.forwardConstIterator();
+        REQUIRE(*(forwardConstIterator + 2U) == 6);
+        REQUIRE(forwardConstIterator.span().size == 3);
+        REQUIRE(forwardConstIterator.span()[0] == 4);
+        for(size_t i = 0; i < forwardConstIterator.size; ++i, ++forwardConstIterator) {
+            REQUIRE(*forwardConstIterator == int(i) + 4);
+        }
+
+        MirroredQueueConstIterator<int> backwardConstIterator = q.backwardConstIterator();
+        for(size_t i = 0; i < backwardConstIterator.size; ++i, --backwardConstIterator) {
+            REQUIRE(*backwardConstIterator == 6 - int(i));
+        }
+    }
+
+    SECTION("Same results with Queue, capacity less than extent") {
+        MovingMetrics<double, 9, EuclideanMeanCumulativeMetrics<double>> moving_metrics{0.0, 5U};
+        MovingMetrics<double, 9, EuclideanMeanCumulativeMetrics<double>, MirroredQueue> moving_metrics_mirrored{0.0, 5U};
+
+        using Shaper = NestedShaperEuclideanCumulative<double, 5, 9, 4, 3>;
+        using ShaperMirrored = QueuedShaperMetrics<MirroredQueue, double, EuclideanDerivativeMetrics<double, 5>, 5, EuclideanMeanCumulativeMetrics<double>, 9, 4, 3>;
+        Shaper shaper{1.0, 7U, 3U, 2U};
+        ShaperMirrored shaper_mirrored{1.0, 7U, 3U, 2U};
+
+        for(int i = 0; i < 50; i++) {
+            const double input = double(i % 11) * 0.5;
+            REQUIRE(moving_metrics.convolute(input) == moving_metrics_mirrored.convolute(input));
+
+            const array<double, 5> derivatives = shaper.convolute(input, 0.01);
+            const array<double, 5> derivatives_mirrored = shaper_mirrored.convolute(input, 0.01);
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE(derivatives[k] == derivatives_mirrored[k]);
+            }
+        }
+    }
+}
@@ -20,6 +20,16 @@ struct EmptyMetrics {
     }
 };
 
+template<typename Type>
+struct SumMetrics {
+    template<typename Iterator>
+    Type operator()(const Type& sum, const Type& popped, const Type& pushed, Iterator forwardIterator, Iterator backwardIterator) const {
+        (void)forwardIterator;
+        (void)backwardIterator;
+        return sum - popped + pushed;
+    }
+};
+
 TEST_CASE("MovingMetrics") {
     SECTION("Constructor") {
         MovingMetrics<int, 4, EmptyMetrics<int>> mm1{11};
@@ -67,4 +77,26 @@ TEST_CASE("MovingMetricsNested") {
         REQUIRE(mmn2.moving_metrics_nested.moving_metrics.capacity() == 7);
         REQUIRE(mmn2.convolute(33) == 33);
     }
+
+    SECTION("Block") {
+        MovingMetricsNested<int, SumMetrics<int>, 4, 3> mmn1{0};
+        MovingMetricsNested<int, SumMetrics<int>, 4, 3> mmn2{0};
+
+        int input[20];
+        int output[20];
+        for(int i = 0; i < 20; i++) {
+            input[i] = i * i - 7 * i;
+        }
+
+        mmn2.convoluteBlock(input, output, 20U);
+        for(size_t i = 0; i < 20U; i++) {
+            REQUIRE(mmn1.convolute(input[i]) == output[i]);
+        }
+
+        // in-place
+        mmn1.convoluteBlock(input, input, 20U);
+        for(size_t i = 0; i < 20U; i++) {
+            REQUIRE(mmn2.convolute(int(i * i) - 7 * int(i)) == input[i]);
+        }
+    }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <nested-shaper/metrics/central_finite_difference_coefficients.hpp>
 
 #include <stdio.h>
+#include <type_traits>
 
 using namespace ns;
 
@@ -547,4 +548,218 @@ TEST_CASE("NestedShaper") {
             REQUIRE_THAT(derivatives[2][i + 1], Catch::Matchers::WithinAbs(derivative_third, 5.0e-2f));
         }
     }
-}
\ No newline at end of file
+    SECTION("Snapshot and Restore") {
+        using Shaper = NestedShaperEuclideanCumulativeArray<double, 3, 5, 11, 7>;
+        static_assert(std::is_trivially_copyable<Shaper>::value, "Shaper should be trivially copyable.");
+
+        Shaper shaper{array<double, 3>{{0.1, 0.2, 0.3}}};
+        for(int i = 0; i < 20; i++) {
+            shaper.convolute(array<double, 3>{{double(i), 0.5 * double(i), -double(i)}}, 0.01);
+        }
+
+        // Evaluate two branches from the same state.
+        const Shaper::state_type state = shaper.snapshot();
+        Shaper copied{shaper};
+        array<array<double, 5>, 3> branches[2];
+        for(int branch = 0; branch < 2; branch++) {
+            shaper.restore(state);
+            for(int i = 0; i < 10; i++) {
+                branches[branch] = shaper.convolute(array<double, 3>{{1.0, 2.0, 3.0}}, 0.01);
+            }
+        }
+
+        array<array<double, 5>, 3> from_copy;
+        for(int i = 0; i < 10; i++) {
+            from_copy = copied.convolute(array<double, 3>{{1.0, 2.0, 3.0}}, 0.01);
+        }
+
+        for(size_t m = 0; m < 3; m++) {
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE(branches[0][m][k] == branches[1][m][k]);
+                REQUIRE(branches[0][m][k] == from_copy[m][k]);
+            }
+        }
+    }
+
+    SECTION("Block convolution") {
+        using Shaper = NestedShaperAngleCumulativeArray<double, 2, 4, 13, 5, 3>;
+        Shaper shaper{array<double, 2>{{0.0, 1.0}}};
+        Shaper shaper_block{array<double, 2>{{0.0, 1.0}}};
+
+        // Longer than a single chunk, and not a multiple of the chunk.
+        constexpr size_t n = 2U * NESTED_SHAPER_BLOCK_SIZE + 7U;
+        array<double, 2> input[n];
+        array<array<double, 4>, 2> output[n];
+        for(size_t i = 0; i < n; i++) {
+            input[i] = array<double, 2>{{0.07 * double(i), 3.0 - 0.05 * double(i)}};
+        }
+
+        shaper_block.convoluteBlock(input, output, n, 0.01);
+        for(size_t i = 0; i < n; i++) {
+            const array<array<double, 4>, 2> derivatives = shaper.convolute(input[i], 0.01);
+            for(size_t m = 0; m < 2; m++) {
+                for(size_t k = 0; k < 4; k++) {
+                    REQUIRE(derivatives[m][k] == output[i][m][k]);
+                }
+            }
+        }
+    }
+
+    SECTION("Decimation") {
+        using Shaper = NestedShaperEuclideanRecursive<double, 5, 11, 7, 3>;
+        Shaper shaper{1.0};
+        Shaper shaper_decimated{1.0};
+        REQUIRE(shaper_decimated.decimation() == 1U);
+
+        constexpr size_t n = 2U * NESTED_SHAPER_BLOCK_SIZE + 11U;
+        double input[n];
+        array<double, 5> output[n];
+        for(size_t i = 0; i < n; i++) {
+            input[i] = 0.3 * double(i % 17U) - 0.01 * double(i);
+        }
+
+        // Factors less than, equal to and greater than the derivative extent
+        const size_t factors[] = {1U, 3U, 5U, 8U};
+        for(const size_t factor : factors) {
+            shaper.initialize(1.0);
+            shaper_decimated.initialize(1.0);
+            shaper_decimated.setDecimation(factor);
+
+            // Split into calls, which do not end at outputs.
+            size_t count = shaper_decimated.convoluteDecimated(input, output, 10U, 0.01);
+            count += shaper_decimated.convoluteDecimated(input + 10U, output + count, n - 10U, 0.01);
+            REQUIRE(count == n / factor);
+
+            size_t k = 0;
+            for(size_t i = 0; i < n; i++) {
+                const array<double, 5> derivatives = shaper.convolute(input[i], 0.01);
+                if((i + 1U) % factor == 0) {
+                    for(size_t j = 0; j < 5; j++) {
+                        REQUIRE(derivatives[j] == output[k][j]);
+                    }
+                    k++;
+                }
+            }
+        }
+    }
+
+    SECTION("Decimation mixed with convolute") {
+        using Shaper = NestedShaperEuclideanRecursive<double, 5, 11, 7, 3>;
+        Shaper shaper{1.0};
+        Shaper shaper_mixed{1.0};
+        shaper_mixed.setDecimation(4U);
+
+        constexpr size_t n = 64U;
+        double input[n];
+        array<double, 5> expected[n];
+        for(size_t i = 0; i < n; i++) {
+            input[i] = 0.3 * double(i % 17U) - 0.01 * double(i);
+            expected[i] = shaper.convolute(input[i], 0.01);
+        }
+
+        // Calls end in the middle of decimation periods, and skipped samples are followed by convolute.
+        const size_t lengths[] = {6U, 3U, 5U, 10U, 1U, 7U, 13U, 2U, 9U, 8U};
+        array<double, 5> output[n];
+        size_t i = 0;
+        for(size_t c = 0; c < sizeof(lengths) / sizeof(lengths[0]); c++) {
+            const size_t length = lengths[c];
+            if(c % 2U == 0) {
+                const size_t count = shaper_mixed.convoluteDecimated(input + i, output, length, 0.01);
+                size_t k = 0;
+                for(size_t j = i; j < i + length; j++) {
+                    if((j + 1U) % 4U == 0) {
+                        for(size_t d = 0; d < 5; d++) {
+                            REQUIRE(output[k][d] == expected[j][d]);
+                        }
+                        k++;
+                    }
+                }
+                REQUIRE(count == k);
+            } else if(c % 4U == 1U) {
+                for(size_t j = i; j < i + length; j++) {
+                    const array<double, 5> derivatives = shaper_mixed.convolute(input[j], 0.01);
+                    for(size_t d = 0; d < 5; d++) {
+                        REQUIRE(derivatives[d] == expected[j][d]);
+                    }
+                }
+            } else {
+                shaper_mixed.convoluteBlock(input + i, output, length, 0.01);
+                for(size_t j = 0; j < length; j++) {
+                    for(size_t d = 0; d < 5; d++) {
+                        REQUIRE(output[j][d] == expected[i + j][d]);
+                    }
+                }
+            }
+            i += length;
+        }
+        REQUIRE(i == n);
+    }
+
+    SECTION("Sub-sample evaluate") {
+        NestedShaperEuclideanRecursive<double, 5, 11, 7, 3> shaper{1.0};
+        NestedShaperEuclideanCumulativeArray<double, 2, 3, 5, 4> shaper_array{array<double, 2>{{1.0, -1.0}}};
+
+        array<double, 5> last = shaper.convolute(1.0, 0.01);
+        array<array<double, 3>, 2> last_array = shaper_array.convolute(array<double, 2>{{1.0, -1.0}}, 0.01);
+        for(size_t i = 0; i < 60; i++) {
+            const double input = 0.3 * double(i % 17U) - 0.01 * double(i);
+            const array<double, 5> at_begin = shaper.evaluate(0.0, 0.01);
+            const array<double, 5> at_end = shaper.evaluate(1.0, 0.01);
+            const array<array<double, 3>, 2> at_end_array = shaper_array.evaluate(1.0, 0.01);
+            for(size_t j = 0; j < 5; j++) {
+                REQUIRE_THAT(at_begin[j], Catch::Matchers::WithinAbs(last[j], 1e-9));
+            }
+
+            last = shaper.convolute(input, 0.01);
+            last_array = shaper_array.convolute(array<double, 2>{{input, -input}}, 0.01);
+            REQUIRE_THAT(at_end[0], Catch::Matchers::WithinAbs(last[0], 1e-9));
+            REQUIRE_THAT(at_end_array[0][0], Catch::Matchers::WithinAbs(last_array[0][0], 1e-9));
+            REQUIRE_THAT(at_end_array[1][0], Catch::Matchers::WithinAbs(last_array[1][0], 1e-9));
+        }
+
+        // Ramp is linear between samples.
+        shaper.initialize(0.0);
+        for(size_t i = 0; i < 30; i++) {
+            last = shaper.convolute(double(i), 0.01);
+        }
+        const array<double, 5> middle = shaper.evaluate(0.5, 0.01);
+        REQUIRE_THAT(middle[0], Catch::Matchers::WithinAbs(last[0] + 0.5, 1e-9));
+        REQUIRE_THAT(middle[1], Catch::Matchers::WithinAbs(100.0, 1e-6));
+        REQUIRE_THAT(middle[2], Catch::Matchers::WithinAbs(0.0, 1e-3));
+    }
+
+    SECTION("Convolute batch") {
+        using Shaper = NestedShaperEuclideanRecursive<double, 3, 11, 7>;
+        using ShaperArray = NestedShaperEuclideanCumulativeArray<double, 2, 3, 5, 4>;
+        Shaper shaper{1.0}, shaper_batch{1.0};
+        ShaperArray shaper_array{array<double, 2>{{1.0, -1.0}}}, shaper_array_batch{array<double, 2>{{1.0, -1.0}}};
+
+        constexpr size_t n = NESTED_SHAPER_BLOCK_SIZE + 13U;
+        double input[n];
+        array<double, 2> input_array[n];
+        for(size_t i = 0; i < n; i++) {
+            input[i] = 0.3 * double(i % 17U) - 0.01 * double(i);
+            input_array[i] = array<double, 2>{{input[i], 2.0 * input[i]}};
+        }
+
+        double positions[n], velocities[n], accelerations[n];
+        shaper_batch.convoluteBatch(input, n, 0.01, DerivativeBuffers<double, 3>{{positions, velocities, accelerations}});
+
+        array<double, 2> positions_array[n], velocities_array[n], accelerations_array[n];
+        shaper_array_batch.convoluteBatch(input_array, n, 0.01, DerivativeBuffers<array<double, 2>, 3>{{positions_array, velocities_array, accelerations_array}});
+
+        for(size_t i = 0; i < n; i++) {
+            const array<double, 3> derivatives = shaper.convolute(input[i], 0.01);
+            REQUIRE(derivatives[0] == positions[i]);
+            REQUIRE(derivatives[1] == velocities[i]);
+            REQUIRE(derivatives[2] == accelerations[i]);
+
+            const array<array<double, 3>, 2> derivatives_array = shaper_array.convolute(input_array[i], 0.01);
+            for(size_t m = 0; m < 2; m++) {
+                REQUIRE(derivatives_array[m][0] == positions_array[i][m]);
+                REQUIRE(derivatives_array[m][1] == velocities_array[i][m]);
+                REQUIRE(derivatives_array[m][2] == accelerations_array[i][m]);
+            }
+        }
+    }
+}
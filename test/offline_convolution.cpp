@@ -0,0 +1,121 @@
+#include <nested-shaper/OfflineConvolution.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <math.h>
+
+using namespace ns;
+
+TEST_CASE("OfflineConvolution") {
+    SECTION("Sizes") {
+        REQUIRE(offline_fft_size(1U) == 2U);
+        REQUIRE(offline_fft_size(5U) == 16U);
+        REQUIRE(offline_fft_size(8U) == 16U);
+        REQUIRE(overlap_add_workspace_size(5U) == 85U);
+    }
+
+    SECTION("FFT") {
+        constexpr size_t n = 16U;
+        double re[n], im[n], cos_[n / 2U], sin_[n / 2U];
+        double input_re[n], input_im[n];
+        for(size_t i = 0; i < n; i++) {
+            input_re[i] = re[i] = 0.3 * double(i % 5U) - 0.7;
+            input_im[i] = im[i] = 0.1 * double(i * i % 7U);
+        }
+
+        fft_twiddles(cos_, sin_, n);
+        fft(re, im, cos_, sin_, n, false);
+
+        // Naive DFT
+        for(size_t k = 0; k < n; k++) {
+            double expected_re{0.0}, expected_im{0.0};
+            for(size_t j = 0; j < n; j++) {
+                const double angle = -2.0 * M_PI * double(k * j) / double(n);
+                expected_re += input_re[j] * ::cos(angle) - input_im[j] * ::sin(angle);
+                expected_im += input_re[j] * ::sin(angle) + input_im[j] * ::cos(angle);
+            }
+
+            REQUIRE_THAT(re[k], Catch::Matchers::WithinAbs(expected_re, 1e-12));
+            REQUIRE_THAT(im[k], Catch::Matchers::WithinAbs(expected_im, 1e-12));
+        }
+
+        fft(re, im, cos_, sin_, n, true);
+        for(size_t i = 0; i < n; i++) {
+            REQUIRE_THAT(re[i], Catch::Matchers::WithinAbs(input_re[i], 1e-12));
+            REQUIRE_THAT(im[i], Catch::Matchers::WithinAbs(input_im[i], 1e-12));
+        }
+    }
+
+    SECTION("Composite kernel") {
+        NestedShaperEuclideanCumulative<double, 3, 5, 5> shaper{0.0, 3U, 2U};
+        REQUIRE(shaper.kernelSize() == 4U);
+
+        double kernel[4];
+        shaper.kernel(kernel);
+        REQUIRE_THAT(kernel[0], Catch::Matchers::WithinAbs(1.0 / 6.0, 1e-15));
+        REQUIRE_THAT(kernel[1], Catch::Matchers::WithinAbs(2.0 / 6.0, 1e-15));
+        REQUIRE_THAT(kernel[2], Catch::Matchers::WithinAbs(2.0 / 6.0, 1e-15));
+        REQUIRE_THAT(kernel[3], Catch::Matchers::WithinAbs(1.0 / 6.0, 1e-15));
+
+        // Impulse response of streaming convolute
+        NestedShaperEuclideanCumulative<double, 3, 9, 7, 4> streaming{0.0};
+        double composite[18];
+        REQUIRE(streaming.kernelSize() == 18U);
+        streaming.kernel(composite);
+
+        double sum{0.0};
+        for(size_t i = 0; i <= 18U; i++) {
+            const array<double, 3> derivatives = streaming.convolute(i == 0 ? 1.0 : 0.0, 1.0);
+            if(i > 0) {
+                REQUIRE_THAT(composite[i - 1U], Catch::Matchers::WithinAbs(derivatives[0], 1e-15)); // central point is one sample late
+                sum += composite[i - 1U];
+            }
+        }
+        REQUIRE_THAT(sum, Catch::Matchers::WithinAbs(1.0, 1e-15));
+    }
+
+    SECTION("Composite kernel of fused and arena shapers") {
+        NestedShaperEuclideanCumulative<double, 3, 9, 7, 4> shaper{0.0, 8U, 5U, 4U};
+        NestedShaperEuclideanCumulativeFused<double, 3, 9, 7, 4> fused{0.0, 8U, 5U, 4U};
+        double storage[Arena<double>::required(8U, 5U, 4U)];
+        Arena<double> arena{storage};
+        NestedShaperEuclideanCumulativeArena<double, 3, 3> arena_shaper{0.0, arena, 8U, 5U, 4U};
+        REQUIRE(arena_shaper.valid());
+
+        REQUIRE(fused.kernelSize() == shaper.kernelSize());
+        REQUIRE(arena_shaper.kernelSize() == shaper.kernelSize());
+
+        double kernel[15], kernel_fused[15], kernel_arena[15];
+        REQUIRE(shaper.kernelSize() == 15U);
+        shaper.kernel(kernel);
+        fused.kernel(kernel_fused);
+        arena_shaper.kernel(kernel_arena);
+        for(size_t i = 0; i < 15U; i++) {
+            REQUIRE(kernel_fused[i] == kernel[i]);
+            REQUIRE(kernel_arena[i] == kernel[i]);
+        }
+    }
+
+    SECTION("Same results with convolute") {
+        constexpr size_t n = 3000U;
+        static double input[n];
+        for(size_t i = 0; i < n; i++) {
+            input[i] = 2.0 + ::sin(0.01 * double(i)) + 0.1 * double(i * 37U % 11U);
+        }
+
+        NestedShaperEuclideanRecursive<double, 5, 100, 50, 20> shaper{0.0, 90U, 50U, 7U};
+        static double workspace[4096];
+        REQUIRE(offline_workspace_size(shaper) <= 4096U);
+
+        static array<double, 5> output[n];
+        shape_offline(shaper, input, output, n, 0.01, workspace, offline_workspace_size(shaper));
+
+        shaper.initialize(input[0]);
+        for(size_t i = 0; i < n; i++) {
+            const array<double, 5> expected = shaper.convolute(input[i], 0.01);
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE_THAT(output[i][k], Catch::Matchers::WithinRel(expected[k], 1e-6) || Catch::Matchers::WithinAbs(expected[k], 1e-6));
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include <nested-shaper/PowerOfTwoQueue.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("PowerOfTwoQueue", "[PowerOfTwoQueue]") {
+    SECTION("Constructor") {
+        PowerOfTwoQueue<int, 5> q;
+        REQUIRE(q.extent == 5);
+        REQUIRE(q.storage == 8);
+        REQUIRE(q.mask == 7);
+        REQUIRE(q.capacity() == 5);
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.isEmpty());
+        REQUIRE_FALSE(q.isFull());
+
+        PowerOfTwoQueue<int, 8> q2(3);
+        REQUIRE(q2.storage == 8);
+        REQUIRE(q2.capacity() == 3);
+        REQUIRE(q2.isEmpty());
+    }
+
+    SECTION("Push and Pop, Front and Back") {
+        PowerOfTwoQueue<int, 3> q;
+        for(int i = 1; i <= 20; i++) {
+            q.push(i);
+        }
+        REQUIRE(q.size() == 3);
+        REQUIRE(q.isFull());
+        REQUIRE(q.front() == 20);
+        REQUIRE(q.front(1) == 19);
+        REQUIRE(q.front(2) == 18);
+        REQUIRE(q.back() == 18);
+        REQUIRE(q.back(1) == 19);
+        REQUIRE(q.back(2) == 20);
+
+        q.pop();
+        REQUIRE(q.size() == 2);
+        REQUIRE(q.back() == 19);
+        REQUIRE(q.shift(21) == 19);
+        REQUIRE(q.front() == 21);
+        REQUIRE(q.back() == 20);
+
+        q.pop();
+        q.pop();
+        REQUIRE(q.isEmpty());
+    }
+
+    SECTION("Iterators") {
+        PowerOfTwoQueue<int, 5> q;
+        for(int i = 1; i <= 6; i++) {
+            q.push(i);
+        }
+        q.pop();
+        q.pop();
+        // Queue contains 4, 5, 6
+
+        PowerOfTwoQueueIterator<int> forwardIterator = q.forwardIterator();
+        REQUIRE(*(forwardIterator + 1U) == 5);
+        REQUIRE(*(forwardIterator + 2U) == 6);
+        for(size_t i = 0; i < forwardIterator.size; ++i, ++forwardIterator) {
+            REQUIRE(*forwardIterator == int(i) + 4);
+        }
+
+        PowerOfTwoQueueConstIterator<int> backwardConstIterator = q.backwardConstIterator();
+        REQUIRE(*(backwardConstIterator - 1U) == 5);
+        REQUIRE(*(backwardConstIterator - 2U) == 4);
+        for(size_t i = 0; i < backwardConstIterator.size; ++i, --backwardConstIterator) {
+            REQUIRE(*backwardConstIterator == 6 - int(i));
+        }
+    }
+
+    SECTION("Resize and Fill") {
+        PowerOfTwoQueue<int, 8> q;
+        q.resize(3);
+        q.fill(7);
+        REQUIRE(q.isFull());
+        REQUIRE(q.size() == 3);
+        q.push(8);
+        REQUIRE(q.front() == 8);
+        REQUIRE(q.back() == 7);
+        REQUIRE(q.back(2) == 8);
+    }
+
+    SECTION("Same results with Queue") {
+        MovingMetrics<double, 7, EuclideanMeanCumulativeMetrics<double>> moving_metrics{0.0};
+        MovingMetrics<double, 7, EuclideanMeanCumulativeMetrics<double>, PowerOfTwoQueue> moving_metrics_pow2{0.0};
+
+        using Shaper = NestedShaperEuclideanRecursive<double, 5, 7, 3, 2>;
+        using ShaperPow2 = QueuedShaperMetrics<PowerOfTwoQueue, double, EuclideanDerivativeMetrics<double, 5>, 5, EuclideanMeanRecursiveMetrics<double>, 7, 3, 2>;
+        Shaper shaper{1.0};
+        ShaperPow2 shaper_pow2{1.0};
+
+        for(int i = 0; i < 50; i++) {
+            const double input = double(i % 11) * 0.5;
+            REQUIRE(moving_metrics.convolute(input) == moving_metrics_pow2.convolute(input));
+
+            const array<double, 5> derivatives = shaper.convolute(input, 0.01);
+            const array<double, 5> derivatives_pow2 = shaper_pow2.convolute(input, 0.01);
+            for(size_t k = 0; k < 5; k++) {
+                REQUIRE(derivatives[k] == derivatives_pow2[k]);
+            }
+        }
+    }
+}
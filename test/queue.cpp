@@ -1,6 +1,7 @@
 #include <nested-shaper/Queue.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <type_traits>
 
 using namespace ns;
 
@@ -179,6 +180,64 @@ TEST_CASE("Queue", "[Queue]") {
         }
     }
 
+    SECTION("Iterators after resize") {
+        Queue<int, 5> q;
+        q.resize(3);
+        q.push(1);
+        q.push(2);
+        q.push(3);
+        q.push(4);
+        // Queue contains 2, 3, 4
+
+        QueueConstIterator<int> forwardConstIterator = q.forwardConstIterator();
+        REQUIRE(*(forwardConstIterator + 2U) == 4);
+        for(size_t i = 0; i < forwardConstIterator.size; ++i, ++forwardConstIterator) {
+            REQUIRE(*forwardConstIterator == int(i) + 2);
+        }
+
+        QueueConstIterator<int> backwardConstIterator = q.backwardConstIterator();
+        REQUIRE(*(backwardConstIterator - 2U) == 2);
+        for(size_t i = 0; i < backwardConstIterator.size; ++i, --backwardConstIterator) {
+            REQUIRE(*backwardConstIterator == 4 - int(i));
+        }
+    }
+
+    SECTION("Bulk push and pop, Segments") {
+        Queue<int, 7> q(5);
+        Queue<int, 7> reference(5);
+        int source[12];
+        int value = 0;
+
+        for(size_t step = 0; step < 40; step++) {
+            const size_t n = (step * 7U) % 12U;
+            for(size_t i = 0; i < n; i++) {
+                source[i] = value++;
+                reference.push(source[i]);
+            }
+            q.pushN(source, n);
+
+            const size_t popped = step % 3U < reference.size() ? step % 3U : reference.size();
+            q.popN(popped);
+            for(size_t i = 0; i < popped; i++) {
+                reference.pop();
+            }
+
+            REQUIRE(q.size() == reference.size());
+            pair<span<const int>, span<const int>> segments = static_cast<const Queue<int, 7>&>(q).segments();
+            REQUIRE(segments.first.size + segments.second.size == q.size());
+            for(size_t i = 0; i < q.size(); i++) {
+                REQUIRE(q.back(i) == reference.back(i));
+                REQUIRE(q.front(i) == reference.front(i));
+                const int segment = i < segments.first.size ? segments.first[i] : segments.second[i - segments.first.size];
+                REQUIRE(segment == reference.back(i));
+            }
+        }
+
+        pair<span<int>, span<int>> segments = q.segments();
+        segments.first[0] = -1;
+        REQUIRE(q.back() == -1);
+    }
+
     SECTION("Fill") {
         Queue<int, 4> q;
         q.fill(1);
@@ -189,4 +248,27 @@ TEST_CASE("Queue", "[Queue]") {
         REQUIRE(q.front() == 2);
         REQUIRE(q.back() == 2);
     };
+
+    SECTION("Copy") {
+        static_assert(std::is_trivially_copyable<Queue<int, 4>>::value, "Queue should be trivially copyable.");
+
+        Queue<int, 4> q;
+        for(int i = 1; i <= 6; i++) {
+            q.push(i);
+        }
+
+        Queue<int, 4> copied{q};
+        q.push(7);
+        REQUIRE(copied.front() == 6);
+        REQUIRE(copied.back() == 3);
+        copied.push(8);
+        REQUIRE(q.front() == 7);
+        REQUIRE(copied.front() == 8);
+
+        // copied contains 4, 5, 6, 8
+        QueueConstIterator<int> forwardConstIterator = copied.forwardConstIterator();
+        REQUIRE(*forwardConstIterator == 4);
+        REQUIRE(*(forwardConstIterator + 2U) == 6);
+        REQUIRE(*(forwardConstIterator + 3U) == 8);
+    };
 }
\ No newline at end of file
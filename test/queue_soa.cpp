@@ -0,0 +1,69 @@
+#include <nested-shaper/QueueSoA.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+template<typename Shaper, typename ShaperSoA, typename Input>
+void requireSameResults(Shaper& shaper, ShaperSoA& shaper_soa, Input input) {
+    for(int i = 0; i < 60; i++) {
+        const auto value = input(i);
+        const auto derivatives = shaper.convolute(value, 0.01);
+        const auto derivatives_soa = shaper_soa.convolute(value, 0.01);
+        for(size_t m = 0; m < derivatives.size(); m++) {
+            for(size_t k = 0; k < derivatives[m].size(); k++) {
+                REQUIRE(derivatives[m][k] == derivatives_soa[m][k]);
+            }
+        }
+    }
+}
+
+TEST_CASE("QueueSoA", "[QueueSoA]") {
+    using array_type = array<float, 3>;
+
+    SECTION("Push and Pop, Front and Back, Lanes") {
+        QueueSoA<array_type, 4> q(3);
+        REQUIRE(q.extent == 4);
+        REQUIRE(q.capacity() == 3);
+        REQUIRE(q.isEmpty());
+
+        for(int i = 1; i <= 10; i++) {
+            q.push(array_type{float(i), float(10 * i), float(100 * i)});
+        }
+        REQUIRE(q.isFull());
+        REQUIRE(q.front()[0] == 10.0f);
+        REQUIRE(q.front(2)[1] == 80.0f);
+        REQUIRE(q.back()[2] == 800.0f);
+
+        for(size_t m = 0; m < 3; m++) {
+            span<const float> lane = q.lane(m);
+            REQUIRE(lane.size == 3);
+            for(size_t i = 0; i < lane.size; i++) {
+                REQUIRE(lane[i] == q.back(i)[m]);
+            }
+        }
+
+        const array_type popped = q.shift(array_type{11.0f, 110.0f, 1100.0f});
+        REQUIRE(popped[0] == 8.0f);
+        REQUIRE(q.forwardConstIterator().lane(1)[2] == 110.0f);
+        REQUIRE((*(q.backwardConstIterator() - 1U))[2] == 1000.0f);
+
+        q.pop();
+        REQUIRE(q.size() == 2);
+        REQUIRE(q.back()[0] == 10.0f);
+    }
+
+    SECTION("Same results with array of structures") {
+        auto euclidean = [](int i) { return array<double, 3>{double(i % 7), double(i % 5) * 2.0, -double(i % 3)}; };
+        auto angle = [](int i) { return array<double, 3>{double(i % 7), 3.0 - double(i % 5), double(i % 3) * 1.5}; };
+
+        NestedShaperEuclideanCumulativeArray<double, 3, 5, 9, 4, 3> euclidean_cumulative{euclidean(0), 7U, 3U, 2U};
+        NestedShaperEuclideanCumulativeArraySoA<double, 3, 5, 9, 4, 3> euclidean_cumulative_soa{euclidean(0), 7U, 3U, 2U};
+        requireSameResults(euclidean_cumulative, euclidean_cumulative_soa, euclidean);
+
+        NestedShaperAngleCumulativeArray<double, 3, 5, 9, 4, 3> angle_cumulative{angle(0), 7U, 3U, 2U};
+        NestedShaperAngleCumulativeArraySoA<double, 3, 5, 9, 4, 3> angle_cumulative_soa{angle(0), 7U, 3U, 2U};
+        requireSameResults(angle_cumulative, angle_cumulative_soa, angle);
+    }
+}
@@ -0,0 +1,66 @@
+#include <nested-shaper/ShaperBank.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("ShaperBank") {
+    constexpr size_t channels = 7U;
+    double inputs[channels];
+    double positions[channels], velocities[channels], accelerations[channels], jerks[channels], snaps[channels];
+    const DerivativeBuffers<double, 5> outputs{{positions, velocities, accelerations, jerks, snaps}};
+
+    SECTION("Same results with NestedShaperEuclideanRecursive") {
+        using Shaper = NestedShaperEuclideanRecursive<double, 5, 11, 7, 3>;
+        ShaperBank<double, channels, 5, 11, 7, 3> bank{1.0, 9U, 7U, 2U};
+        Shaper shapers[channels] = {Shaper{1.0, 9U, 7U, 2U}, Shaper{1.0, 9U, 7U, 2U}, Shaper{1.0, 9U, 7U, 2U}, Shaper{1.0, 9U, 7U, 2U}, Shaper{1.0, 9U, 7U, 2U}, Shaper{1.0, 9U, 7U, 2U}, Shaper{1.0, 9U, 7U, 2U}};
+        REQUIRE(bank.capacity(0) == 9U);
+        REQUIRE(bank.capacity(2) == 2U);
+
+        for(size_t i = 0; i < 100; i++) {
+            if(i == 40) {
+                // Only the channel 3 is reset.
+                bank.initializeChannel(3U, -2.0);
+                shapers[3].initialize(-2.0);
+            }
+
+            for(size_t c = 0; c < channels; c++) {
+                inputs[c] = 0.3 * double((i + c) % 17U) - 0.01 * double(i * c);
+            }
+
+            bank.convolute(inputs, 0.01, outputs);
+            for(size_t c = 0; c < channels; c++) {
+                const array<double, 5> derivatives = shapers[c].convolute(inputs[c], 0.01);
+                REQUIRE(derivatives[0] == positions[c]);
+                REQUIRE(derivatives[1] == velocities[c]);
+                REQUIRE(derivatives[2] == accelerations[c]);
+                REQUIRE(derivatives[3] == jerks[c]);
+                REQUIRE(derivatives[4] == snaps[c]);
+            }
+        }
+    }
+
+    SECTION("Initialize every channel") {
+        ShaperBank<double, channels, 5, 4, 3> bank{0.0};
+        const double values[channels] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+        bank.initialize(values);
+        bank.convolute(values, 0.01, outputs);
+        for(size_t c = 0; c < channels; c++) {
+            REQUIRE(positions[c] == values[c]);
+            REQUIRE_THAT(velocities[c], Catch::Matchers::WithinAbs(0.0, 1e-9));
+        }
+
+        // Step of every channel
+        for(size_t i = 0; i < 12; i++) {
+            for(size_t c = 0; c < channels; c++) {
+                inputs[c] = values[c] + 1.0;
+            }
+            bank.convolute(inputs, 0.01, outputs);
+        }
+        for(size_t c = 0; c < channels; c++) {
+            REQUIRE_THAT(positions[c], Catch::Matchers::WithinAbs(values[c] + 1.0, 1e-12));
+            REQUIRE_THAT(velocities[c], Catch::Matchers::WithinAbs(0.0, 1e-9));
+        }
+    }
+}
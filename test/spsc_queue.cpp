@@ -0,0 +1,99 @@
+#include <nested-shaper/SPSCQueue.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <thread>
+
+using namespace ns;
+
+TEST_CASE("SPSCQueue", "[SPSCQueue]") {
+    SECTION("Push and Pop") {
+        SPSCQueue<int, 3> q;
+        REQUIRE(q.capacity() == 3);
+        REQUIRE(q.isEmpty());
+
+        int value{0};
+        REQUIRE_FALSE(q.pop(value));
+        REQUIRE(q.push(1));
+        REQUIRE(q.push(2));
+        REQUIRE(q.push(3));
+        REQUIRE_FALSE(q.push(4));
+        REQUIRE(q.size() == 3);
+
+        REQUIRE(q.pop(value));
+        REQUIRE(value == 1);
+        REQUIRE(q.push(4));
+        REQUIRE(q.pop(value));
+        REQUIRE(value == 2);
+
+        q.reset();
+        REQUIRE(q.isEmpty());
+        REQUIRE_FALSE(q.pop(value));
+    }
+
+    SECTION("Producer and consumer threads") {
+        static SPSCQueue<size_t, 64> q;
+        constexpr size_t count = 200000U;
+
+        std::thread producer([&]() {
+            for(size_t i = 0; i < count;) {
+                if(q.push(i)) {
+                    i++;
+                }
+            }
+        });
+
+        size_t expected{0};
+        size_t value{0};
+        while(expected < count) {
+            if(q.pop(value)) {
+                REQUIRE(value == expected);
+                expected++;
+            }
+        }
+        producer.join();
+        REQUIRE(q.isEmpty());
+    }
+}
+
+TEST_CASE("ShaperPipeline", "[ShaperPipeline]") {
+    using Shaper = NestedShaperEuclideanRecursive<double, 3, 5, 3>;
+    ShaperPipeline<Shaper, 8> pipeline{0.0};
+    Shaper reference{0.0};
+
+    REQUIRE(pipeline.submit(1.0));
+    REQUIRE(pipeline.submit(2.0));
+
+    // 1.0, 2.0, then holds 2.0
+    const double inputs[4] = {1.0, 2.0, 2.0, 2.0};
+    for(size_t i = 0; i < 4; i++) {
+        const array<double, 3> shaped = pipeline.tick(0.01);
+        const array<double, 3> expected = reference.convolute(inputs[i], 0.01);
+        for(size_t k = 0; k < 3; k++) {
+            REQUIRE(shaped[k] == expected[k]);
+        }
+    }
+    REQUIRE(pipeline.underruns() == 2);
+
+    REQUIRE(pipeline.submit(5.0));
+    pipeline.initialize(3.0);
+    REQUIRE(pipeline.underruns() == 0);
+    REQUIRE(pipeline.tick(0.01)[0] == 3.0);
+    REQUIRE(pipeline.underruns() == 1);
+
+    // tickLatest skips to the most recent setpoint
+    Shaper latest{3.0};
+    REQUIRE(pipeline.submit(4.0));
+    REQUIRE(pipeline.submit(6.0));
+    REQUIRE(pipeline.submit(7.0));
+    const array<double, 3> shaped = pipeline.tickLatest(0.01);
+    latest.convolute(3.0, 0.01);
+    const array<double, 3> expected = latest.convolute(7.0, 0.01);
+    for(size_t k = 0; k < 3; k++) {
+        REQUIRE(shaped[k] == expected[k]);
+    }
+    REQUIRE(pipeline.underruns() == 1);
+    pipeline.tickLatest(0.01);
+    REQUIRE(pipeline.underruns() == 2);
+}
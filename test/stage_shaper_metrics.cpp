@@ -0,0 +1,50 @@
+#include <nested-shaper/StageShaperMetrics.hpp>
+#include <nested-shaper/NestedShaper.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("StageShaperMetrics") {
+    SECTION("Same as backward differences of the output") {
+        NestedShaperEuclideanRecursiveStage<double, 4, 11, 7, 3> shaper{1.0, 9U, 7U, 2U};
+        NestedShaperEuclideanRecursiveFused<double, 1, 11, 7, 3> reference{1.0, 9U, 7U, 2U};
+        REQUIRE(shaper.capacity(0) == 9U);
+
+        const double dt = 0.01;
+        double outputs[4] = {1.0, 1.0, 1.0, 1.0}; // outputs[i] : i samples ago
+        for(size_t i = 0; i < 100; i++) {
+            const double input = 0.3 * double(i % 17U) - 0.01 * double(i);
+            const array<double, 4> derivatives = shaper.convolute(input, dt);
+
+            for(size_t j = 3; j > 0; j--) {
+                outputs[j] = outputs[j - 1U];
+            }
+            outputs[0] = reference.convolute(input, dt)[0];
+
+            REQUIRE(derivatives[0] == outputs[0]);
+            REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinAbs((outputs[0] - outputs[1]) / dt, 1e-9));
+            REQUIRE_THAT(derivatives[2], Catch::Matchers::WithinAbs((outputs[0] - 2.0 * outputs[1] + outputs[2]) / (dt * dt), 1e-6));
+            REQUIRE_THAT(derivatives[3], Catch::Matchers::WithinAbs((outputs[0] - 3.0 * outputs[1] + 3.0 * outputs[2] - outputs[3]) / (dt * dt * dt), 1e-3));
+        }
+    }
+
+    SECTION("Ramp") {
+        NestedShaperEuclideanCumulativeStage<double, 3, 5, 4> shaper{0.0};
+        array<double, 3> derivatives{};
+        for(size_t i = 0; i < 20; i++) {
+            derivatives = shaper.convolute(double(i), 0.1);
+        }
+
+        // No delay of the derivative queue, position lags only the moving averages.
+        REQUIRE_THAT(derivatives[0], Catch::Matchers::WithinAbs(19.0 - 2.0 - 1.5, 1e-12));
+        REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinAbs(10.0, 1e-9));
+        REQUIRE_THAT(derivatives[2], Catch::Matchers::WithinAbs(0.0, 1e-6));
+
+        shaper.initialize(2.0);
+        derivatives = shaper.convolute(2.0, 0.1);
+        REQUIRE(derivatives[0] == 2.0);
+        REQUIRE(derivatives[1] == 0.0);
+        REQUIRE(derivatives[2] == 0.0);
+    }
+}
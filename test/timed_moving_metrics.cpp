@@ -0,0 +1,98 @@
+#include <nested-shaper/TimedMovingMetrics.hpp>
+#include <nested-shaper/metrics/euclidean_derivative_metrics.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ns;
+
+TEST_CASE("TimedMovingMetrics") {
+    SECTION("Linear") {
+        TimedMovingMetrics<double, double, 8U> metrics(0.0, 0.0, 0.5);
+        double mean = metrics.convolute(0.25, 0.5); // 0.0 ~ 0.25 : 0.0 to 0.5
+        REQUIRE_THAT(mean, Catch::Matchers::WithinAbs(0.125, 1e-12));
+        mean = metrics.convolute(0.5, 1.0);
+        REQUIRE_THAT(mean, Catch::Matchers::WithinAbs(0.5, 1e-12));
+        mean = metrics.convolute(0.6, 1.2);
+        REQUIRE_THAT(mean, Catch::Matchers::WithinAbs(0.7, 1e-12));
+        REQUIRE(metrics.size() == 4U);
+    }
+
+    SECTION("Zero order hold") {
+        TimedMovingMetrics<double, double, 8U, true> metrics(0.0, 0.0, 1.0);
+        REQUIRE(metrics.convolute(0.25, 1.0) == 0.0);
+        REQUIRE_THAT(metrics.convolute(0.5, 1.0), Catch::Matchers::WithinAbs(0.25, 1e-12));
+        REQUIRE_THAT(metrics.convolute(1.25, 1.0), Catch::Matchers::WithinAbs(1.0, 1e-12));
+    }
+
+    SECTION("Gap larger than window") {
+        TimedMovingMetrics<double, double, 4U> metrics(2.0, 0.0, 1.0);
+        REQUIRE_THAT(metrics.convolute(5.0, 2.0), Catch::Matchers::WithinAbs(2.0, 1e-12));
+        REQUIRE_THAT(metrics.convolute(10.0, 7.0), Catch::Matchers::WithinAbs(6.5, 1e-12));
+        REQUIRE(metrics.size() == 2U);
+    }
+
+    SECTION("Saturated window") {
+        TimedMovingMetrics<double, double, 4U> metrics(1.0, 0.0, 1.0);
+        REQUIRE_FALSE(metrics.saturated());
+
+        // 6 samples of 0.0 and 2.0 in turn within the window of 1.0, more than extent of 4
+        double mean{0.0};
+        for(int i = 1; i <= 6; i++) {
+            mean = metrics.convolute(0.1 * double(i), i % 2 == 0 ? 0.0 : 2.0);
+        }
+        REQUIRE(metrics.saturated());
+        REQUIRE(metrics.size() == 5U);
+
+        // Mean over the shortened window [0.2, 0.6], neither divided by the full window nor extrapolated
+        REQUIRE_THAT(mean, Catch::Matchers::WithinAbs(1.0, 1e-12));
+
+        // Once the window passes the oldest sample, the full window is back
+        REQUIRE_THAT(metrics.convolute(1.5, 2.0), Catch::Matchers::WithinAbs(1.0, 1e-12)); // [0.5, 1.5]
+        REQUIRE(metrics.saturated());
+
+        metrics.initialize(1.0, 2.0);
+        REQUIRE_FALSE(metrics.saturated());
+    }
+
+    SECTION("Jittered linear input") {
+        const double a = 3.0, b = -1.0;
+        const double windows[3] = {0.05, 0.03, 0.02};
+        TimedMovingMetricsNested<double, double, false, 16U, 16U, 16U> nested(b, 0.0, windows[0], windows[1], windows[2]);
+        TimedShaperMetrics<double, double, 3U, false, 16U, 16U, 16U> shaper(b, 0.0, windows[0], windows[1], windows[2]);
+
+        double t = 0.0;
+        double times[3] = {};
+        for(int i = 0; i < 200; i++) {
+            t += 0.005 + 0.003 * double((i * 7) % 5) / 4.0; // 5ms ~ 8ms
+            times[0] = times[1];
+            times[1] = times[2];
+            times[2] = t;
+
+            const double mean = nested.convolute(t, a * t + b);
+            const array<double, 3> derivatives = shaper.convolute(t, a * t + b);
+            if(t > 0.2) {
+                REQUIRE_THAT(mean, Catch::Matchers::WithinAbs(a * (t - 0.05) + b, 1e-9));
+                REQUIRE_THAT(derivatives[0], Catch::Matchers::WithinAbs(a * (times[1] - 0.05) + b, 1e-9));
+                REQUIRE_THAT(derivatives[1], Catch::Matchers::WithinAbs(a, 1e-6));
+                REQUIRE_THAT(derivatives[2], Catch::Matchers::WithinAbs(0.0, 1e-3));
+            }
+        }
+    }
+
+    SECTION("Same derivatives with uniform times") {
+        const double dt = 0.01;
+        Queue<TimedSample<double, double>, 5U> timed;
+        Queue<double, 5U> uniform;
+        const double values[5] = {1.0, 2.0, 4.0, 3.0, -1.0};
+        for(int i = 0; i < 5; i++) {
+            timed.push(TimedSample<double, double>{0.3 + dt * double(i), values[i]});
+            uniform.push(values[i]);
+        }
+
+        const array<double, 5> expected = EuclideanDerivativeMetrics<double, 5U>{}(uniform.forwardConstIterator(), uniform.backwardConstIterator(), dt);
+        const array<double, 5> derivatives = EuclideanDerivativeNonUniformMetrics<double, 5U>{}(timed.forwardConstIterator(), timed.backwardConstIterator());
+        for(size_t k = 0; k < 5U; k++) {
+            REQUIRE_THAT(derivatives[k], Catch::Matchers::WithinRel(expected[k], 1e-6));
+        }
+    }
+}
@@ -20,4 +20,12 @@ TEST_CASE("tiny_utility") {
         angle = wrap(angle, 10.0f, 20.0f);
         REQUIRE(fabs(angle - 17.0f) < 1e-4f);
     }
-}
\ No newline at end of file
+    SECTION("taylor_shift") {
+        // 1 + 2t + 3t^2 + 4t^3 at 0 : 1, 2, 6, 24
+        const array<double, 4> shifted = taylor_shift(array<double, 4>{{1.0, 2.0, 6.0, 24.0}}, 0.5);
+        REQUIRE(fabs(shifted[0] - 3.25) < 1e-12);
+        REQUIRE(fabs(shifted[1] - 8.0) < 1e-12);
+        REQUIRE(fabs(shifted[2] - 18.0) < 1e-12);
+        REQUIRE(fabs(shifted[3] - 24.0) < 1e-12);
+    }
+}